@@ -0,0 +1,272 @@
+#include "bench.h"
+
+static Allocations allocations = {};
+
+void* operator new(size_t size)
+{
+  // keep allocation size in front of the block for delete
+  auto block = static_cast<size_t*>(malloc(size + sizeof(max_align_t)));
+  if (!block)
+    throw bad_alloc();
+
+  *block = size;
+  ++allocations.count;
+  allocations.live += size;
+  allocations.peak = _max(allocations.peak, allocations.live);
+  return reinterpret_cast<ubyte_t*>(block) + sizeof(max_align_t);
+}
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (!ptr)
+    return;
+
+  auto block = reinterpret_cast<size_t*>(static_cast<ubyte_t*>(ptr) - sizeof(max_align_t));
+  allocations.live -= *block;
+  free(block);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    _InitCli();
+    if (argc > 2 && string_view(argv[1]) == "--corpus")
+      RunCorpus(argv[2], (argc > 3) ? stoull(argv[3]) : 256);
+    else if (argc > 1 && string_view(argv[1]) == "--scan")
+      RunScanBenchmark((argc > 2) ? argv[2] : "");
+    else
+      RunBenchmark((argc > 1) ? stoull(argv[1]) : 100ull << 20);
+  }
+  catch (const exception& e) {
+    cout << e.what() << endl << flush;
+    _TerminateCli(EXIT_FAILURE);
+  }
+  _TerminateCli(EXIT_SUCCESS);
+}
+
+void _InitCli()
+{
+  _set_error_mode(_OUT_TO_STDERR);
+  cout << _format("36", "\n\tRunning benchmarks\n\n") << flush;
+}
+
+void _TerminateCli(int code)
+{
+  if (!code)
+    cout << _format("32", "\n\tSuccessfully finished benchmarks\n\n") << flush;
+  exit(code);
+}
+
+/**
+  @brief Parses generated configs with Settings::Config and prints throughput
+  @param maxSize Size of the largest generated config in bytes
+**/
+void RunBenchmark(const size_t maxSize)
+{
+  static constexpr size_t kSizes[] = { 1ull << 10, 16ull << 10, 256ull << 10, 4ull << 20, 32ull << 20, 100ull << 20 };
+  static constexpr Shape kShapes[] = { Shape::Flat, Shape::Deep, Shape::Strings, Shape::Comments };
+
+  const path directory = L"./benchConfigs";
+  create_directories(directory);
+
+  cout << left << setw(10) << "shape" << right << setw(12) << "bytes" << setw(12) << "MB/s"
+       << setw(12) << "allocs" << setw(12) << "peak KB" << endl;
+  for (auto size : kSizes) {
+    if (size > maxSize)
+      break;
+
+    for (auto shape : kShapes) {
+      const path file = directory / (string(ShapeName(shape)) + "_" + to_string(size) + ".lua");
+      {
+        auto source = Generator(shape)(size);
+        ofstream(file, ios::binary).write(source.data(), source.size());
+      }
+
+      // repeat small configs so timings are above clock resolution
+      size_t runs = 0;
+      size_t count = 0;
+      size_t peak = 0;
+      chrono::duration<double> elapsed(0);
+      do {
+        const auto base = allocations;
+        allocations.peak = allocations.live;
+        auto start = chrono::steady_clock::now();
+        {
+          Settings::Config config(file);
+        }
+        elapsed += chrono::steady_clock::now() - start;
+        count += allocations.count - base.count;
+        peak = _max(peak, allocations.peak - base.live);
+        ++runs;
+      } while (elapsed.count() < 0.5 && runs < 10000);
+
+      auto bytes = static_cast<double>(file_size(file));
+      cout << left << setw(10) << ShapeName(shape) << right << setw(12) << static_cast<size_t>(bytes)
+           << setw(12) << fixed << setprecision(1) << bytes * runs / elapsed.count() / (1 << 20)
+           << setw(12) << count / runs << setw(12) << peak / 1024 << endl << flush;
+    }
+  }
+}
+
+/**
+  @brief Writes generated and mutated configs to directory and parses every file in it
+  @param directory Corpus directory, files already in it are parsed as well
+  @param count     Amount of configs generated per shape
+**/
+void RunCorpus(const path& directory, const size_t count)
+{
+  static constexpr Shape kShapes[] = { Shape::Flat, Shape::Deep, Shape::Strings, Shape::Comments };
+
+  create_directories(directory);
+  for (auto shape : kShapes) {
+    for (size_t i = 0; i < count; ++i) {
+      Generator generator(shape, static_cast<uint32_t>(i + 1));
+      auto source = generator(0x100 << (i % 7));
+      auto name = string(ShapeName(shape)) + "_" + to_string(i) + ".lua";
+      ofstream(directory / ("valid_" + name), ios::binary).write(source.data(), source.size());
+
+      generator.Mutate(source, 1 + i % 16);
+      ofstream(directory / ("mutated_" + name), ios::binary).write(source.data(), source.size());
+    }
+  }
+
+  // valid configs must parse, anything else may only fail with a runtime error
+  size_t parsed = 0;
+  size_t rejected = 0;
+  for (auto& entry : directory_iterator(directory)) {
+    if (!entry.is_regular_file())
+      continue;
+
+    try {
+      Settings::Config config(entry.path());
+      ++parsed;
+    }
+    catch (const runtime_error&) {
+      if (entry.path().filename().wstring().starts_with(L"valid_"))
+        throw;
+      ++rejected;
+    }
+  }
+  cout << parsed << " parsed, " << rejected << " rejected" << endl << flush;
+}
+
+/**
+  @brief Compares Memory::Scanner on every supported instruction set against a naive loop
+  @param filename Binary to be scanned, 256 MB of generated code-like bytes when empty
+**/
+void RunScanBenchmark(const path& filename)
+{
+  static constexpr ubyte_t kCommon[] = { 0x00, 0x48, 0x89, 0x8B, 0x0F, 0xE8, 0x4C, 0x24, 0x83, 0xCC, 0xC3, 0x85 };
+
+  vector<ubyte_t> data;
+  if (filename.empty()) {
+    mt19937 rng(1);
+    data.resize(256ull << 20);
+    for (auto& byte : data)
+      byte = (rng() & 1) ? kCommon[rng() % sizeof(kCommon)] : static_cast<ubyte_t>(rng());
+  }
+  else {
+    data.resize(static_cast<size_t>(file_size(filename)));
+    ifstream(filename, ios::binary).read(reinterpret_cast<char*>(data.data()), data.size());
+  }
+  Memory::Pattern pattern("48 8B 05 ?? ?? ?? ?? 48 85 C0 74 ?? E8");
+
+  // single thread until thread scaling is measured
+  auto threads = Memory::GetThreadCount();
+  Memory::SetThreadCount(1);
+
+  auto measure = [&](const char* name, auto&& scan) {
+    auto start = chrono::steady_clock::now();
+    auto matches = scan();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << left << setw(10) << name << right << setw(12) << fixed << setprecision(2)
+         << data.size() / elapsed.count() / (1 << 30) << " GB/s" << setw(10) << matches << " matches" << endl << flush;
+  };
+
+  measure("naive", [&] {
+    size_t matches = 0;
+    for (size_t i = 0; i + pattern.Size() <= data.size(); ++i) {
+      size_t j = 0;
+      while (j < pattern.Size() && (data[i + j] & pattern.GetMask()[j]) == pattern.GetBytes()[j])
+        ++j;
+      matches += (j == pattern.Size());
+    }
+    return matches;
+  });
+
+  static constexpr pair<Memory::Isa, const char*> kIsas[] = {
+    { Memory::Isa::Scalar, "scalar" }, { Memory::Isa::Sse2, "sse2" }, { Memory::Isa::Avx2, "avx2" }
+  };
+  auto supported = Memory::Scanner::GetSupportedIsa();
+  for (auto& [isa, name] : kIsas) {
+    if (isa > supported)
+      break;
+    Memory::Scanner::SetIsa(isa);
+    measure(name, [&] { return Memory::Scanner(data.data(), data.size()).FindAll(pattern).size(); });
+  }
+  Memory::Scanner::SetIsa(supported);
+
+  // startup-like workload, hundreds of signatures cut from scanned bytes
+  mt19937 rng(2);
+  vector<Memory::Pattern> patterns;
+  for (auto i = 0; i < 300; ++i) {
+    auto offset = rng() % (data.size() - 16);
+    string signature;
+    for (auto j = 0; j < 16; ++j) {
+      char byte[4];
+      sprintf_s(byte, "%02X ", data[offset + j]);
+      signature += (j % 5 == 3) ? "?? " : byte;
+    }
+    patterns.emplace_back(signature);
+  }
+  Memory::PatternSet set(patterns);
+  Memory::Scanner scanner(data.data(), data.size());
+
+  cout << endl << patterns.size() << " patterns" << endl;
+  measure("separate", [&] {
+    size_t matches = 0;
+    for (auto& p : patterns)
+      matches += scanner.FindAll(p).size();
+    return matches;
+  });
+  measure("set", [&] {
+    size_t matches = 0;
+    for (auto& found : scanner.FindAll(set))
+      matches += found.size();
+    return matches;
+  });
+
+  // same scans split into chunks across threads
+  for (size_t count = 1; count <= threads; count = (count == threads) ? count + 1 : _min(count * 2, threads)) {
+    Memory::SetThreadCount(count);
+    cout << endl << count << " threads" << endl;
+    measure("pattern", [&] { return scanner.FindAll(pattern).size(); });
+    measure("set", [&] {
+      size_t matches = 0;
+      for (auto& found : scanner.FindAll(set))
+        matches += found.size();
+      return matches;
+    });
+  }
+  Memory::SetThreadCount(threads);
+}
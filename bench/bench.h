@@ -0,0 +1,26 @@
+#pragma once
+
+#include "base.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include "settings.h"
+#include "memory.h"
+#include "generator.h"
+
+/**
+  @brief Heap usage recorded by the global allocation hooks
+**/
+struct Allocations {
+  size_t count; //!< Amount of allocations made
+  size_t live;  //!< Bytes currently allocated
+  size_t peak;  //!< Highest value of live since last reset
+};
+
+static void _InitCli();
+static void _TerminateCli(int code);
+static void RunBenchmark(const size_t maxSize);
+static void RunCorpus(const path& directory, const size_t count);
+static void RunScanBenchmark(const path& filename);
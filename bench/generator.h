@@ -0,0 +1,197 @@
+#pragma once
+
+#include "base.h"
+
+#include <random>
+
+/**
+  @brief Config shapes the generator is able to produce
+**/
+enum class Shape {
+  Flat,     //!< Plain name = value pairs
+  Deep,     //!< Tables nested up to kMaxDepth levels
+  Strings,  //!< Long multi-line [[ ]] strings
+  Comments  //!< More comments than entries
+};
+
+static const char* ShapeName(const Shape shape)
+{
+  switch (shape) {
+  case Shape::Flat: return "flat";
+  case Shape::Deep: return "deep";
+  case Shape::Strings: return "strings";
+  default: return "comments";
+  }
+}
+
+/**
+  @brief Deterministic generator of valid config sources
+**/
+class Generator {
+public:
+  static constexpr size_t kMaxDepth = 32;
+
+  Generator(const Shape shape, const uint32_t seed = 1) : shape_(shape), rng_(seed) {}
+
+  /**
+    @brief  Generates config source close to given size
+    @param  size Target size in bytes, output is never smaller
+    @retval      Config source
+  **/
+  string operator()(const size_t size)
+  {
+    string out;
+    out.reserve(size + 0x1000);
+    names_ = 0;
+    while (out.size() < size) {
+      switch (shape_) {
+      case Shape::Flat:
+        Entry_(out, 0);
+        out += '\n';
+        break;
+      case Shape::Deep:
+        Table_(out, 1 + Next_(kMaxDepth));
+        break;
+      case Shape::Strings:
+        Name_(out);
+        out += " = ";
+        LongString_(out, 0x100 + Next_(0x1000));
+        out += '\n';
+        break;
+      case Shape::Comments:
+        for (auto count = 1 + Next_(3); count; --count)
+          Comment_(out);
+        Entry_(out, 0);
+        out += '\n';
+        break;
+      }
+    }
+    return out;
+  }
+
+  /**
+    @brief Damages source with syntax-relevant edits
+    @param source Config source to be mutated in place
+    @param edits  Amount of edits to be made
+  **/
+  void Mutate(string& source, const size_t edits)
+  {
+    static constexpr char kTokens[] = "{}[]=,'\"-\n ";
+    for (size_t i = 0; i < edits && !source.empty(); ++i) {
+      auto pos = Next_(source.size());
+      auto token = kTokens[Next_(sizeof(kTokens) - 1)];
+      switch (Next_(3)) {
+      case 0:
+        source[pos] = token;
+        break;
+      case 1:
+        source.insert(source.begin() + pos, token);
+        break;
+      default:
+        source.erase(pos, 1 + Next_(8));
+        break;
+      }
+    }
+  }
+
+private:
+  Shape   shape_;
+  mt19937 rng_;
+  size_t  names_; //!< Names generated so far
+
+  size_t Next_(const size_t bound)
+  {
+    return uniform_int_distribution<size_t>(0, bound - 1)(rng_);
+  }
+
+  void Name_(string& out)
+  {
+    // names only allow letters and underscores
+    auto n = names_++;
+    do {
+      out += static_cast<char>('a' + n % 26);
+      n /= 26;
+    } while (n);
+    if (!Next_(4))
+      out += "_key";
+  }
+
+  void Value_(string& out)
+  {
+    switch (Next_(4)) {
+    case 0:
+      out += to_string(Next_(100000));
+      break;
+    case 1:
+      out += '-';
+      out += to_string(Next_(1000));
+      out += '.';
+      out += to_string(Next_(1000));
+      out += 'f';
+      break;
+    case 2:
+      out += "'./some/path/file_";
+      out += to_string(Next_(1000));
+      out += ".txt'";
+      break;
+    default:
+      out += Next_(2) ? "true" : "false";
+      break;
+    }
+  }
+
+  void Entry_(string& out, const size_t depth)
+  {
+    out.append(depth * 2, ' ');
+    Name_(out);
+    out += " = ";
+    Value_(out);
+  }
+
+  void Table_(string& out, const size_t depth)
+  {
+    Name_(out);
+    out += " = {\n";
+    for (size_t level = 1; level < depth; ++level) {
+      for (auto count = Next_(3); count; --count) {
+        Entry_(out, level);
+        out += ",\n";
+      }
+      out.append(level * 2, ' ');
+      Name_(out);
+      out += " = {\n";
+    }
+    Entry_(out, depth);
+    out += '\n';
+    for (auto level = depth; level; --level) {
+      out.append((level - 1) * 2, ' ');
+      out += (level > 1) ? "},\n" : "}\n";
+    }
+  }
+
+  void LongString_(string& out, const size_t size)
+  {
+    static constexpr char kWords[][8] = { "lorem", "ipsum", "dolor", "sit", "amet", "potato" };
+    out += "[[\n";
+    for (size_t line = 0; line < size; line += 64) {
+      for (size_t column = 0; column < 64; column += 6) {
+        out += kWords[Next_(sizeof(kWords) / sizeof(*kWords))];
+        out += ' ';
+      }
+      out += '\n';
+    }
+    out += "]]";
+  }
+
+  void Comment_(string& out)
+  {
+    if (Next_(2)) {
+      out += "-- single line comment about the next entry\n";
+      return;
+    }
+    out += "[[--\n";
+    for (auto lines = 1 + Next_(8); lines; --lines)
+      out += "  multi-line comment line that is skipped by the parser\n";
+    out += "--]]\n";
+  }
+};
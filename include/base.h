@@ -24,6 +24,8 @@
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 #include <dbgeng.h>
+#include <TlHelp32.h>
+#include <intrin.h>
 #include <wchar.h>
 #include <string>
 #include <iostream>
@@ -35,9 +37,20 @@
 #include <initializer_list>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <regex>
 #include <limits>
 #include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <bit>
+#include <functional>
+#include <algorithm>
+#include <span>
 
 #ifdef max
 #undef max
@@ -195,3 +208,27 @@ string string_lower(const string& upper)
 
   return lower;
 }
+
+/**
+  @brief  FNV-1a hash of a string, usable at compile time
+  @param  str  String to be hashed
+  @param  seed Hash to continue from, allows hashing strings by parts
+  @retval uint64_t String hash
+**/
+constexpr uint64_t string_hash(const string_view& str, uint64_t seed = 0xCBF29CE484222325u) noexcept
+{
+  for (auto c = str.begin(); c != str.end(); ++c) {
+    seed ^= static_cast<ubyte_t>(*c);
+    seed *= 0x100000001B3u;
+  }
+  return seed;
+}
+
+constexpr uint64_t string_hash(const wstring_view& str, uint64_t seed = 0xCBF29CE484222325u) noexcept
+{
+  for (auto c = str.begin(); c != str.end(); ++c) {
+    seed ^= static_cast<ushort_t>(*c);
+    seed *= 0x100000001B3u;
+  }
+  return seed;
+}
@@ -52,3 +52,18 @@ inline R CallMethod(uintptr_t address, C this_, Args&&... args)
 #include "memory/process.h"
 #include "memory/trampoline.h"
 #include "memory/data.h"
+#include "memory/parallel.h"
+#include "memory/scanner.h"
+#include "memory/decoder.h"
+#include "memory/analysis.h"
+#include "memory/import.h"
+#include "memory/vtable.h"
+#include "memory/image.h"
+#include "memory/pointerpath.h"
+#include "memory/remote.h"
+#include "memory/memorymap.h"
+#include "memory/valuescanner.h"
+#include "memory/writewatch.h"
+#include "memory/snapshot.h"
+#include "memory/watchdog.h"
+#include "memory/cave.h"
@@ -0,0 +1,347 @@
+/**
+  @brief     Analysis submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "process.h"
+#include "decoder.h"
+#include "image.h"
+#include "scanner.h"
+
+namespace Memory
+{
+
+/**
+  @class Analysis
+  @brief Object used to keep resolved hook targets of a module between runs
+
+  Targets are stored as RVAs with their decoded prologue length and the bytes
+  found there, in a file keyed by module timestamp, checksum and image size.
+  A cached target is only trusted while its bytes still match. Snapshots stop
+  before the first relocated byte, so they match at any load address.
+**/
+class Analysis {
+public:
+  static constexpr size_t kJumpSize = (sizeof(pvoid_t) == 8) ? 12 : 5; //!< Bytes overwritten by a hook jump
+
+  /**
+    @struct Target
+    @brief  Resolved hook target
+  **/
+  struct Target {
+    Pointer address;  //!< Target address, nullptr if not found
+    size_t  prologue; //!< Length of whole instructions covering a hook jump
+  };
+
+  /**
+    @brief Analysis object constructor
+    @param module   Analysed module
+    @param filename Path to cache file, ignored if it belongs to another module build
+  **/
+  Analysis(const Module& module, const path& filename) :
+    module_(module), filename_(filename), isDirty_(false), isIndexed_(false), hits_(0), misses_(0)
+  {
+    auto nt = module_.GetNtHeaders();
+    header_ = { magic_, version_, nt->FileHeader.TimeDateStamp, nt->OptionalHeader.CheckSum,
+                nt->OptionalHeader.SizeOfImage, 0 };
+
+    ifstream file(filename_, ios::binary);
+    Header_ header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != header_.magic ||
+        header.version != header_.version || header.timestamp != header_.timestamp ||
+        header.checksum != header_.checksum || header.imageSize != header_.imageSize)
+      return;
+
+    Record_ record;
+    for (uint32_t i = 0; i < header.count && file.read(reinterpret_cast<char*>(&record), sizeof(record)); ++i)
+      records_[record.hash] = record;
+  }
+
+  /**
+    @brief Analysis object destructor, saves newly resolved targets
+  **/
+  ~Analysis()
+  {
+    if (isDirty_)
+      Save();
+  }
+
+  Analysis(const Analysis&) = delete;
+  Analysis& operator=(const Analysis&) = delete;
+
+  /**
+    @brief  Resolves named target, running resolver only when not cached or stale
+    @param  name     Unique target name
+    @param  resolver Returns target address, nullptr if not found
+    @retval          Resolved target
+  **/
+  template<class F> requires is_invocable_r_v<Pointer, F>
+  Target Resolve(const string_view& name, F&& resolver)
+  {
+    auto hash = string_hash(name);
+    auto cached = Lookup_(hash);
+    if (cached.address.ToVoid())
+      return cached;
+    return Store_(hash, resolver());
+  }
+
+  /**
+    @brief  Resolves named target by signature
+    @param  name    Unique target name
+    @param  pattern Signature scanned for in module executable sections
+    @retval         Resolved target
+  **/
+  Target Resolve(const string_view& name, const Pattern& pattern)
+  {
+    return Resolve(name, [&] {
+      return Scanner(module_).Find(pattern);
+    });
+  }
+
+  /**
+    @brief  Resolves named targets by signature, scanning once for all that are not cached
+    @param  signatures Unique target names and their signatures
+    @retval            Resolved targets in signatures order
+  **/
+  vector<Target> Resolve(const vector<pair<string, Pattern>>& signatures)
+  {
+    vector<Target> targets(signatures.size(), { nullptr, 0 });
+    vector<size_t> missing;
+    vector<Pattern> patterns;
+    for (size_t i = 0; i < signatures.size(); ++i) {
+      targets[i] = Lookup_(string_hash(signatures[i].first));
+      if (!targets[i].address.ToVoid()) {
+        missing.push_back(i);
+        patterns.push_back(signatures[i].second);
+      }
+    }
+    if (missing.empty())
+      return targets;
+
+    auto found = Scanner(module_).FindFirst(PatternSet(move(patterns)));
+    for (size_t i = 0; i < missing.size(); ++i)
+      targets[missing[i]] = Store_(string_hash(signatures[missing[i]].first), found[i]);
+    return targets;
+  }
+
+  /**
+    @brief Writes cache file, replacing it at once so readers never see a partial file
+  **/
+  void Save() noexcept
+  {
+    if (Write_(filename_, header_, records_))
+      isDirty_ = false;
+  }
+
+  /**
+    @brief  Resolves targets of an image file offline and writes a cache file runtime starts from
+    @param  image      Image file of analysed module
+    @param  signatures Unique target names and their signatures
+    @param  filename   Path to cache file
+    @retval            Targets in signatures order, addresses are RVAs and prologue is 0 if not hookable
+    @note   Snapshots stop before relocated bytes, so they match at any load address
+  **/
+  static vector<Target> Plan(const Image& image, const vector<pair<string, Pattern>>& signatures, const path& filename)
+  {
+    vector<Target> targets(signatures.size(), { nullptr, 0 });
+    auto nt = image.GetNtHeaders();
+    Header_ header = { magic_, version_, nt->FileHeader.TimeDateStamp, nt->OptionalHeader.CheckSum,
+                       nt->OptionalHeader.SizeOfImage, 0 };
+    unordered_map<uint64_t, Record_> records;
+
+    vector<Pattern> patterns;
+    for (auto& [name, pattern] : signatures)
+      patterns.push_back(pattern);
+    auto found = (patterns.empty()) ? vector<Pointer>() : Scanner(image).FindFirst(PatternSet(move(patterns)));
+
+    for (size_t i = 0; i < found.size(); ++i) {
+      auto rva = image.ToRva(found[i]);
+      if (!found[i].ToVoid() || !rva)
+        continue;
+
+      Record_ record = { string_hash(signatures[i].first), rva };
+      while (record.size < sizeof(record.bytes) && image.FromRva(rva + record.size).ToVoid() &&
+             !image.IsRelocated(rva + record.size, 1))
+        ++record.size;
+      memcpy(record.bytes, found[i].ToBytes(), record.size);
+
+      // decoder may read a whole instruction past prologue
+      if (image.FromRva(rva, kJumpSize + 2 * kMaxInstruction).ToVoid())
+        record.prologue = static_cast<ubyte_t>(DecodePrologue(found[i], kJumpSize));
+      // target starting with a relocated pointer has no bytes to be verified against
+      if (record.size)
+        records[record.hash] = record;
+      targets[i] = { static_cast<uintptr_t>(rva), record.prologue };
+    }
+
+    if (!Write_(filename, header, records))
+      _throws("Could not write analysis file");
+    return targets;
+  }
+
+  /**
+    @brief  Gets amount of targets served from cache
+    @retval size_t Cache hits
+  **/
+  constexpr size_t GetHits() const noexcept
+  {
+    return hits_;
+  }
+
+  /**
+    @brief  Gets amount of targets that had to be resolved
+    @retval size_t Cache misses, stale targets included
+  **/
+  constexpr size_t GetMisses() const noexcept
+  {
+    return misses_;
+  }
+
+private:
+  struct Header_ {
+    uint32_t magic;     //!< File signature
+    uint32_t version;   //!< File layout version
+    uint32_t timestamp; //!< Module link timestamp
+    uint32_t checksum;  //!< Module image checksum
+    uint32_t imageSize; //!< Module image size
+    uint32_t count;     //!< Amount of records
+  };
+
+  struct Record_ {
+    uint64_t hash;      //!< Target name hash
+    uint32_t rva;       //!< Target address relative to module base
+    ubyte_t  prologue;  //!< Prologue length
+    ubyte_t  size;      //!< Amount of bytes in snapshot
+    ubyte_t  bytes[32]; //!< Bytes found at target
+  };
+
+  static constexpr uint32_t magic_ = 0x414C5359; //!< "YSLA"
+  static constexpr uint32_t version_ = 1;
+
+  Module                             module_;
+  path                               filename_;
+  Header_                            header_;
+  unordered_map<uint64_t, Record_>   records_;
+  vector<uint32_t>                   relocations_; //!< Sorted RVAs of relocated pointers, indexed on first store
+  bool                               isDirty_;
+  bool                               isIndexed_;
+  size_t                             hits_;
+  size_t                             misses_;
+
+  static bool Write_(const path& filename, Header_ header, const unordered_map<uint64_t, Record_>& records) noexcept
+  {
+    try {
+      auto temporary = path(filename) += L".tmp";
+      {
+        header.count = static_cast<uint32_t>(records.size());
+        ofstream file(temporary, ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (auto& [hash, record] : records)
+          file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        if (!file)
+          return false;
+      }
+      rename(temporary, filename);
+      return true;
+    }
+    catch (const exception&) {
+      return false;
+    }
+  }
+
+  Target Lookup_(const uint64_t hash)
+  {
+    auto record = records_.find(hash);
+    // empty snapshot would match any bytes
+    if (record != records_.end() && record->second.size && record->second.rva + record->second.size <= header_.imageSize) {
+      Pointer address = module_.GetBaseAddress() + record->second.rva;
+      if (!memcmp(address.ToBytes(), record->second.bytes, record->second.size)) {
+        ++hits_;
+        return { address, record->second.prologue };
+      }
+    }
+    return { nullptr, 0 };
+  }
+
+  Target Store_(const uint64_t hash, const Pointer& address)
+  {
+    ++misses_;
+    auto base = module_.GetBaseAddress().ToValue();
+    if (!address.ToVoid() || address < base || address.ToValue() - base >= header_.imageSize) {
+      if (records_.erase(hash))
+        isDirty_ = true;
+      return { address, 0 };
+    }
+
+    Record_ record = { hash, static_cast<uint32_t>(address.ToValue() - base) };
+    record.prologue = static_cast<ubyte_t>(DecodePrologue(address, kJumpSize));
+    auto size = min<size_t>(sizeof(record.bytes), header_.imageSize - record.rva);
+    while (record.size < size && !IsRelocated_(record.rva + record.size))
+      ++record.size;
+    if (!record.size) {
+      if (records_.erase(hash))
+        isDirty_ = true;
+      return { address, record.prologue };
+    }
+    memcpy(record.bytes, address.ToBytes(), record.size);
+    records_[hash] = record;
+    isDirty_ = true;
+    return { address, record.prologue };
+  }
+
+  bool IsRelocated_(const uint32_t rva)
+  {
+    if (!isIndexed_) {
+      IndexRelocations_();
+      isIndexed_ = true;
+    }
+    auto found = lower_bound(relocations_.begin(), relocations_.end(), (rva >= sizeof(pvoid_t)) ? rva - sizeof(pvoid_t) + 1 : 0);
+    return found != relocations_.end() && *found <= rva;
+  }
+
+  void IndexRelocations_()
+  {
+    auto base = module_.GetBaseAddress();
+    auto& entry = module_.GetNtHeaders()->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_BASERELOC];
+    if (entry.VirtualAddress > header_.imageSize || entry.Size > header_.imageSize - entry.VirtualAddress)
+      return;
+
+    for (uint32_t offset = 0; offset + sizeof(IMAGE_BASE_RELOCATION) <= entry.Size;) {
+      auto block = Pointer(base + entry.VirtualAddress + offset).ToObject<IMAGE_BASE_RELOCATION>();
+      if (block->SizeOfBlock < sizeof(IMAGE_BASE_RELOCATION) || block->SizeOfBlock > entry.Size - offset)
+        break;
+
+      auto count = (block->SizeOfBlock - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(ushort_t);
+      auto items = reinterpret_cast<const ushort_t*>(block + 1);
+      for (size_t i = 0; i < count; ++i) {
+        auto type = items[i] >> 12;
+        if (type == IMAGE_REL_BASED_HIGHLOW || type == IMAGE_REL_BASED_DIR64)
+          relocations_.push_back(block->VirtualAddress + (items[i] & 0xFFF));
+      }
+      offset += block->SizeOfBlock;
+    }
+    sort(relocations_.begin(), relocations_.end());
+  }
+};
+
+}
@@ -395,7 +395,7 @@ class Instruction {
 class Patch {
 public:
   Patch(const Pointer ptr = nullptr, const size_t maxSize = 48u) :
-    ptr_(ptr), original_({}), payload_({}), isEnabled_(false),
+    ptr_(ptr), original_({}), payload_({}), isEnabled_(false), isOwned_(false),
     maxSize_(maxSize), offset_(0), symbols_({ {} })
   {
     if (&ptr_ == nullptr) {
@@ -403,12 +403,14 @@ class Patch {
       if (tmp == nullptr)
         _throws("Can't allocate heap memory");
       ptr_ = tmp;
+      isOwned_ = true;
     }
   }
 
   ~Patch()
   {
-    HeapFree(GetProcessHeap(), 0, ptr_.ToVoid());
+    if (isOwned_)
+      HeapFree(GetProcessHeap(), 0, ptr_.ToVoid());
   }
 
   void Symbols(initializer_list<pair<const string, const string>> il)
@@ -459,26 +461,63 @@ class Patch {
     return ptr_;
   }
 
-  constexpr void Enable()
+  constexpr const Pointer& GetAddress() const noexcept
   {
-    if (!isEnabled_)
+    return ptr_;
+  }
+
+  constexpr const Data& GetPayload() const noexcept
+  {
+    return payload_;
+  }
+
+  constexpr const Data& GetOriginal() const noexcept
+  {
+    return original_;
+  }
+
+  bool IsEnabled() const noexcept
+  {
+    return isEnabled_;
+  }
+
+  void Enable()
+  {
+    lock_guard<mutex> lock(mutex_);
+    if (!isEnabled_) {
       Write(ptr_, payload_, payload_.Size());
+      isEnabled_ = true;
+    }
   }
 
-  constexpr void Disable()
+  void Disable()
   {
-    if (isEnabled_)
+    lock_guard<mutex> lock(mutex_);
+    if (isEnabled_) {
       Write(ptr_, original_, original_.Size());
+      isEnabled_ = false;
+    }
+  }
+
+  /**
+    @brief  Locks patch state, Enable and Disable wait until lock is released
+    @retval Lock held over state and patched bytes
+  **/
+  unique_lock<mutex> Lock() const
+  {
+    return unique_lock<mutex>(mutex_);
   }
 
 private:
   Pointer ptr_;
   Data payload_;
   Data original_;
-  bool isEnabled_;
+  atomic<bool> isEnabled_;
+  bool isOwned_; //!< Was memory allocated by patch?
   size_t maxSize_;
   size_t offset_;
   vector<pair<const string, const string>> symbols_;
+  mutable mutex mutex_; //!< Guards state while bytes are written
 };
 
 }
@@ -0,0 +1,281 @@
+/**
+  @brief     Cave submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "process.h"
+#include "data.h"
+#include "scanner.h"
+
+namespace Memory
+{
+
+/**
+  @struct Cave
+  @brief  Run of padding bytes inside executable memory
+**/
+struct Cave {
+  Pointer address;
+  size_t  size;
+  ubyte_t filler; //!< 0xCC, 0x90 or 0x00
+};
+
+/**
+  @brief  Finds padding runs in a range of code
+  @param  ptr     Start of range
+  @param  size    Amount of bytes
+  @param  minSize Smallest run returned
+  @retval         Caves in ascending address order
+
+  Runs of int3 are never executed. Runs of nop may be executed as alignment inside a
+  function, so they only count when following a ret or int3. Runs of zero may be
+  data, so they only count when reaching the end of range (e.g. section slack).
+**/
+inline vector<Cave> FindCaves(const Pointer& ptr, const size_t size, const size_t minSize = 16)
+{
+  static constexpr size_t kWidth = 32;
+  auto data = ptr.ToAny<const ubyte_t*>();
+  auto isa = Scanner::GetIsa();
+  auto isFiller = [](const ubyte_t byte) noexcept { return byte == 0xCC || byte == 0x90 || byte == 0x00; };
+
+  // bit set for each filler byte in kWidth bytes
+  auto mask = [&](const size_t pos) noexcept -> uint32_t {
+    if (isa == Isa::Avx2) {
+      auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+      auto fillers = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(0xCC))),
+                                                     _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(0x90)))),
+                                     _mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+      return static_cast<uint32_t>(_mm256_movemask_epi8(fillers));
+    }
+    uint32_t bits = 0;
+    for (size_t half = 0; half < kWidth; half += 16) {
+      auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + half));
+      auto fillers = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(0xCC))),
+                                               _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(0x90)))),
+                                  _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+      bits |= static_cast<uint32_t>(_mm_movemask_epi8(fillers)) << half;
+    }
+    return bits;
+  };
+
+  vector<Cave> caves;
+  auto length = max<size_t>(min<size_t>(minSize, kWidth), 1);
+  size_t pos = 0;
+  size_t cached = size; // position of mask kept from previous window
+  uint32_t next = 0;
+  while (pos < size) {
+    // windows of 64 bytes show every run of length filler bytes starting in their first half
+    size_t start = size;
+    if (isa != Isa::Scalar && pos + 2 * kWidth <= size) {
+      auto first = (cached == pos) ? next : mask(pos);
+      next = mask(pos + kWidth);
+      cached = pos + kWidth;
+      auto runs = first | (static_cast<uint64_t>(next) << kWidth);
+      for (size_t run = 1; run < length;) {
+        auto shift = min<size_t>(run, length - run);
+        runs &= runs >> shift;
+        run += shift;
+      }
+      runs &= 0xFFFFFFFFu;
+      if (!runs) {
+        pos += kWidth;
+        continue;
+      }
+      start = pos + countr_zero(runs);
+    }
+    else {
+      for (start = pos; start < size && !isFiller(data[start]); ++start);
+      if (start == size)
+        break;
+    }
+
+    // candidate may mix fillers, so the run of its first byte is measured
+    auto filler = data[start];
+    auto end = start + 1;
+    while (end < size && data[end] == filler)
+      ++end;
+    auto isSafe = (filler == 0xCC) || (filler == 0x90 && start && (data[start - 1] == 0xC3 || data[start - 1] == 0xCC)) ||
+                  (filler == 0x00 && end == size);
+    if (end - start >= minSize && isSafe)
+      caves.push_back({ const_cast<ubyte_t*>(data + start), end - start, filler });
+    pos = end;
+  }
+  return caves;
+}
+
+/**
+  @brief  Finds padding runs in executable sections of a module, slack up to the end of their last page included
+  @param  module  Module to be scanned
+  @param  minSize Smallest run returned
+  @retval         Caves in ascending address order
+**/
+inline vector<Cave> FindCaves(const Module& module, const size_t minSize = 16)
+{
+  constexpr size_t kPageSize = 0x1000;
+  vector<Cave> caves;
+  auto nt = module.GetNtHeaders();
+  auto section = IMAGE_FIRST_SECTION(nt);
+  for (auto i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+    if (!(section->Characteristics & IMAGE_SCN_MEM_EXECUTE))
+      continue;
+    // loader maps sections up to the end of their last page, pages past it up to
+    // section alignment may be left unmapped
+    auto size = (section->Misc.VirtualSize + kPageSize - 1) & ~(kPageSize - 1);
+    auto found = FindCaves(module.GetBaseAddress() + section->VirtualAddress, size, minSize);
+    caves.insert(caves.end(), found.begin(), found.end());
+  }
+  return caves;
+}
+
+/**
+  @class CavePool
+  @brief Hands out pieces of code caves for small stubs
+
+  Allocated pieces are made of cave bytes, the caller writes the stub with a
+  Protection in place. Freed pieces get their padding back, so they stay caves.
+**/
+class CavePool {
+public:
+  /**
+    @brief CavePool object constructor
+    @param caves Caves to be handed out
+  **/
+  CavePool(vector<Cave> caves) : free_(move(caves))
+  {
+    sort(free_.begin(), free_.end(), Less_);
+  }
+
+  /**
+    @brief CavePool object constructor, caves are taken from executable sections of a module
+    @param module  Module to be scanned
+    @param minSize Smallest cave used
+  **/
+  CavePool(const Module& module, const size_t minSize = 16) : CavePool(FindCaves(module, minSize)) {}
+
+  /**
+    @brief  Takes a piece of a cave
+    @param  size      Amount of bytes
+    @param  near      Address piece must be reachable from with rel32, nullptr for any
+    @param  alignment Alignment of piece start
+    @retval           Piece address, nullptr if no cave fits
+  **/
+  Pointer Allocate(const size_t size, const Pointer& near = nullptr, const size_t alignment = 16)
+  {
+    for (size_t i = 0; i < free_.size(); ++i) {
+      auto& cave = free_[i];
+      auto begin = cave.address.ToValue();
+      auto start = (begin + alignment - 1) / alignment * alignment;
+      if (!size || start + size > begin + cave.size)
+        continue;
+      if (near.ToValue() && !(IsNear_(near.ToValue(), start) && IsNear_(near.ToValue(), start + size)))
+        continue;
+
+      Cave piece{ start, size, cave.filler };
+      Cave tail{ start + size, begin + cave.size - (start + size), cave.filler };
+      cave.size = start - begin;
+      if (!cave.size)
+        free_.erase(free_.begin() + i);
+      if (tail.size)
+        free_.insert(upper_bound(free_.begin(), free_.end(), tail, Less_), tail);
+      used_.emplace(start, piece);
+      return piece.address;
+    }
+    return nullptr;
+  }
+
+  /**
+    @brief  Gives a piece back, restoring its padding
+    @param  ptr Address returned by Allocate
+    @retval     False if ptr was not allocated by this pool
+  **/
+  bool Free(const Pointer& ptr)
+  {
+    auto found = used_.find(ptr.ToValue());
+    if (found == used_.end())
+      return false;
+    auto piece = found->second;
+    used_.erase(found);
+    Fill(piece.address, piece.filler, piece.size);
+
+    // merges with neighbouring free pieces of the same cave
+    auto next = free_.insert(upper_bound(free_.begin(), free_.end(), piece, Less_), piece);
+    if (next + 1 != free_.end() && IsAdjacent_(*next, next[1])) {
+      next->size += next[1].size;
+      free_.erase(next + 1);
+    }
+    if (next != free_.begin() && IsAdjacent_(next[-1], *next)) {
+      next[-1].size += next->size;
+      free_.erase(next);
+    }
+    return true;
+  }
+
+  /**
+    @brief  Gets caves not handed out
+    @retval Free caves in ascending address order
+  **/
+  constexpr const vector<Cave>& GetFree() const noexcept
+  {
+    return free_;
+  }
+
+  /**
+    @brief  Gets amount of free bytes
+    @retval size_t Bytes in every free cave
+  **/
+  size_t GetFreeSize() const noexcept
+  {
+    size_t size = 0;
+    for (auto& cave : free_)
+      size += cave.size;
+    return size;
+  }
+
+private:
+  vector<Cave>                   free_; //!< Sorted by address
+  unordered_map<uintptr_t, Cave> used_; //!< Allocated pieces by address
+
+  static bool Less_(const Cave& l, const Cave& r) noexcept
+  {
+    return l.address.ToValue() < r.address.ToValue();
+  }
+
+  static bool IsAdjacent_(const Cave& l, const Cave& r) noexcept
+  {
+    return l.filler == r.filler && l.address.ToValue() + l.size == r.address.ToValue();
+  }
+
+  /**
+    @brief  Checks if rel32 displacement reaches between two addresses
+    @param  from Address of instruction
+    @param  to   Target address
+    @retval      Is target reachable?
+  **/
+  static constexpr bool IsNear_(const uintptr_t from, const uintptr_t to) noexcept
+  {
+    auto distance = (from > to) ? from - to : to - from;
+    return distance < 0x7FFF0000u;
+  }
+};
+
+}
@@ -28,82 +28,234 @@
 namespace Memory
 {
 
-class Data : private vector<ubyte_t> {
+/**
+  @brief  Copies memory that may be unmapped or unreadable, without changing its protection
+  @param  ptr   Source address
+  @param  out   Destination buffer
+  @param  size  Amount of bytes
+  @retval bool  Were all bytes copied?
+**/
+inline bool SafeRead(const Pointer& ptr, void* out, const size_t size) noexcept
+{
+  SIZE_T read = 0;
+  return !size || (ReadProcessMemory(GetCurrentProcess(), ptr.ToVoid(), out, size, &read) && read == size);
+}
+
+/**
+  @class Data
+  @brief Byte buffer keeping small payloads inline, copies are done with a single memcpy
+**/
+class Data {
 public:
-  Data() : vector<ubyte_t>({})
+  static constexpr size_t kInlineSize = 32; //!< Bytes stored without allocating
+
+  Data() noexcept : data_(inline_), size_(0), capacity_(kInlineSize)
   {
   }
 
-  Data(initializer_list<ubyte_t> values) : vector<ubyte_t>(values)
+  Data(initializer_list<ubyte_t> values) : Data()
   {
+    Append(values.begin(), values.size());
+  }
+
+  Data(const void* bytes, const size_t size) : Data()
+  {
+    Append(bytes, size);
+  }
+
+  Data(const Data& other) : Data()
+  {
+    Append(other.data_, other.size_);
+  }
+
+  Data(Data&& other) noexcept : Data()
+  {
+    Swap_(other);
+  }
+
+  ~Data()
+  {
+    Free_();
+  }
+
+  Data& operator=(const Data& other)
+  {
+    if (this != &other) {
+      size_ = 0;
+      Append(other.data_, other.size_);
+    }
+    return *this;
+  }
+
+  Data& operator=(Data&& other) noexcept
+  {
+    if (this != &other) {
+      Free_();
+      data_ = inline_;
+      size_ = 0;
+      capacity_ = kInlineSize;
+      Swap_(other);
+    }
+    return *this;
   }
 
   constexpr size_t Size() const noexcept
   {
-    return size();
+    return size_;
+  }
+
+  constexpr size_t Capacity() const noexcept
+  {
+    return capacity_;
   }
+
   constexpr void Clear() noexcept
   {
-    return clear();
+    size_ = 0;
   }
 
   const Pointer Bytes() noexcept
   {
-    return data();
+    return data_;
+  }
+
+  constexpr const ubyte_t* Bytes() const noexcept
+  {
+    return data_;
+  }
+
+  /**
+    @brief Grows storage ahead of appends
+    @param capacity Minimum amount of bytes stored without reallocating
+  **/
+  void Reserve(const size_t capacity)
+  {
+    if (capacity > capacity_)
+      delete[] Grow_(capacity);
+  }
+
+  /**
+    @brief  Appends bytes
+    @param  bytes Bytes to be appended
+    @param  size  Amount of bytes
+    @retval Data& This object reference
+  **/
+  Data& Append(const void* bytes, const size_t size)
+  {
+    // bytes may live in old storage, so it is freed after copying
+    ubyte_t* previous = nullptr;
+    if (size_ + size > capacity_)
+      previous = Grow_(max<size_t>(size_ + size, capacity_ * 2));
+    if (size)
+      memcpy(data_ + size_, bytes, size);
+    size_ += size;
+    delete[] previous;
+    return *this;
   }
 
   template<class T>
   const T& PushObject(const T& value)
   {
-    auto last = size();
-    resize(last + sizeof(value), 0u);
-    return (*reinterpret_cast<T*>(data() + last) = value);
+    auto last = size_;
+    Append(&value, sizeof(T));
+    return *reinterpret_cast<T*>(data_ + last);
   }
 
   template<class T>
   const T PopObject()
   {
-    auto last = size();
-    auto offset = last - sizeof(T);
-    if (offset >= last || sizeof(T) > last)
+    if (sizeof(T) > size_)
       _throws("Tried to pop object larger than vector size");
 
-    auto obj = *reinterpret_cast<T*>(data() + offset - 1);
-    resize(offset);
+    T obj;
+    size_ -= sizeof(T);
+    memcpy(&obj, data_ + size_, sizeof(T));
     return obj;
   }
 
   template<class T>
   const T& ReadObject(const size_t offset)
   {
-    if (size() < offset + sizeof(T))
+    if (size_ < offset + sizeof(T))
       _throws("Tried to read object larger than vector size");
-    return *reinterpret_cast<T*>(data() + offset);
+    return *reinterpret_cast<T*>(data_ + offset);
   }
 
   friend void Read(const Pointer& ptr, Data& data, const size_t count, const bool vp = true)
   {
     Protection protection(ptr, (vp) ? count : 0);
-    for (Pointer p = ptr; p < ptr + count; ++p)
-      data.push_back(*p);
+    data.Append(ptr.ToVoid(), count);
   }
 
   friend void Write(Pointer& ptr, Data& data, const size_t count, const bool vp = true)
   {
     Protection protection(ptr, (vp) ? count : 0);
-    memcpy_s(&ptr, count, data.data(), data.size());
+    memcpy_s(&ptr, count, data.data_, data.size_);
+  }
+
+  /**
+    @brief  Appends memory that may be unmapped or unreadable, without changing its protection
+    @param  ptr  Source address
+    @param  data Destination, left unchanged if read fails
+    @param  size Amount of bytes
+    @retval bool Were all bytes copied?
+  **/
+  friend bool SafeRead(const Pointer& ptr, Data& data, const size_t size)
+  {
+    data.Reserve(data.size_ + size);
+    if (!SafeRead(ptr, data.data_ + data.size_, size))
+      return false;
+    data.size_ += size;
+    return true;
   }
 
   friend Data& operator+=(Data& l, const Data& r)
   {
-    for (auto b = r.begin(); b != r.end(); ++b)
-      l.emplace_back(*b);
-    return l;
+    return l.Append(r.data_, r.size_);
   }
 
   const ubyte_t& operator[](const size_t index) const
   {
-    return at(index);
+    if (index >= size_)
+      _throws("Index out of range");
+    return data_[index];
+  }
+
+private:
+  ubyte_t* data_;     //!< Inline buffer or heap storage
+  size_t   size_;     //!< Amount of bytes stored
+  size_t   capacity_; //!< Amount of bytes storage holds
+  ubyte_t  inline_[kInlineSize];
+
+  void Free_() noexcept
+  {
+    if (data_ != inline_)
+      delete[] data_;
+  }
+
+  ubyte_t* Grow_(const size_t capacity)
+  {
+    auto previous = (data_ != inline_) ? data_ : nullptr;
+    auto grown = new ubyte_t[capacity];
+    memcpy(grown, data_, size_);
+    data_ = grown;
+    capacity_ = capacity;
+    return previous;
+  }
+
+  void Swap_(Data& other) noexcept
+  {
+    // heap storage moves by pointer, inline bytes get copied
+    if (other.data_ != other.inline_) {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+    }
+    else
+      memcpy(inline_, other.inline_, other.size_);
+    size_ = other.size_;
+    other.data_ = other.inline_;
+    other.size_ = 0;
+    other.capacity_ = kInlineSize;
   }
 };
 
@@ -121,6 +273,22 @@ inline T& WriteObject(Pointer& ptr, const T& value, const bool vp = true)
   return (*ptr.ToObject<T>() = value);
 };
 
+/**
+  @brief  Reads object that may be unmapped or unreadable, without changing its protection
+  @param  ptr   Object address
+  @param  value Output object, left unchanged if read fails
+  @retval bool  Was object read?
+**/
+template<class T>
+inline bool SafeReadObject(const Pointer& ptr, T& value) noexcept
+{
+  T read;
+  if (!SafeRead(ptr, &read, sizeof(T)))
+    return false;
+  value = read;
+  return true;
+}
+
 inline void Fill(Pointer& ptr, const ubyte_t& value, const size_t size, const bool vp = true)
 {
   Protection protection(ptr, (vp) ? size : 0);
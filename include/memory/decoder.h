@@ -0,0 +1,165 @@
+/**
+  @brief     Decoder submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+
+namespace Memory
+{
+
+inline constexpr size_t kMaxInstruction = 15; //!< Longest valid instruction in bytes
+
+/**
+  @brief  Decodes length of a single x86/x64 instruction
+  @param  code  Instruction bytes, at least 15 readable bytes
+  @param  is64  Decode in 64-bit mode
+  @retval       Instruction length, 0 if not decodable
+**/
+inline size_t DecodeLength(const ubyte_t* code, const bool is64 = sizeof(pvoid_t) == 8) noexcept
+{
+  auto p = code;
+  auto isOperand16 = false;
+  auto isAddress16 = false;
+  auto isRexW = false;
+
+  // legacy prefixes, then REX right before opcode
+  for (;; ++p) {
+    if (p - code >= 14)
+      return 0;
+    if (*p == 0x66)
+      isOperand16 = true;
+    else if (*p == 0x67)
+      isAddress16 = true;
+    else if (*p != 0xF0 && *p != 0xF2 && *p != 0xF3 && *p != 0x2E && *p != 0x36 &&
+             *p != 0x3E && *p != 0x26 && *p != 0x64 && *p != 0x65)
+      break;
+  }
+  if (is64 && (*p & 0xF0) == 0x40)
+    isRexW = *p++ & 8;
+
+  auto immz = (isOperand16) ? 2u : 4u;
+  auto op = *p++;
+  ubyte_t map = 0;
+  auto hasModRm = false;
+  size_t imm = 0;
+
+  if (op == 0xC5 && (is64 || (*p & 0xC0) == 0xC0)) { // 2-byte VEX
+    ++p;
+    map = 1;
+  }
+  else if (op == 0xC4 && (is64 || (*p & 0xC0) == 0xC0)) { // 3-byte VEX
+    map = p[0] & 0x1F;
+    p += 2;
+  }
+  else if (op == 0x62 && is64) { // EVEX
+    map = p[0] & 0x03;
+    p += 3;
+  }
+  else if (op == 0x0F) {
+    map = 1;
+    if (*p == 0x38 || *p == 0x3A)
+      map = (*p++ == 0x38) ? 2 : 3;
+  }
+
+  if (map) {
+    op = *p++;
+    if (map == 1 && (op == 0x05 || op == 0x06 || op == 0x07 || op == 0x08 || op == 0x09 || op == 0x0B ||
+                     op == 0x0E || op == 0x77 || op == 0xA0 || op == 0xA1 || op == 0xA2 || op == 0xA8 ||
+                     op == 0xA9 || op == 0xAA || (op >= 0x30 && op <= 0x37) || (op >= 0xC8 && op <= 0xCF)))
+      hasModRm = false;
+    else if (map == 1 && op >= 0x80 && op <= 0x8F) // jcc rel32
+      imm = immz;
+    else {
+      hasModRm = true;
+      if (map == 3 || (map == 1 && ((op >= 0x70 && op <= 0x73) || op == 0xA4 || op == 0xAC || op == 0xBA ||
+                                    op == 0xC2 || op == 0xC4 || op == 0xC5 || op == 0xC6 || op == 0x0F)))
+        imm = 1;
+    }
+  }
+  else {
+    if (op < 0x40)
+      hasModRm = (op & 7) < 4;
+    else
+      hasModRm = op == 0x62 || op == 0x63 || op == 0x69 || op == 0x6B || (op >= 0x80 && op <= 0x8F) ||
+                 op == 0xC0 || op == 0xC1 || (op >= 0xC4 && op <= 0xC7) || (op >= 0xD0 && op <= 0xD3) ||
+                 (op >= 0xD8 && op <= 0xDF) || op == 0xF6 || op == 0xF7 || op == 0xFE || op == 0xFF;
+
+    if ((op < 0x40 && (op & 7) == 4) || op == 0x6A || op == 0x6B || (op >= 0x70 && op <= 0x7F) ||
+        op == 0x80 || op == 0x82 || op == 0x83 || op == 0xA8 || (op >= 0xB0 && op <= 0xB7) || op == 0xC0 ||
+        op == 0xC1 || op == 0xC6 || op == 0xCD || op == 0xD4 || op == 0xD5 || (op >= 0xE0 && op <= 0xE7) || op == 0xEB)
+      imm = 1;
+    else if ((op < 0x40 && (op & 7) == 5) || op == 0x68 || op == 0x69 || op == 0x81 || op == 0xA9 ||
+             op == 0xC7 || op == 0xE8 || op == 0xE9)
+      imm = immz;
+    else if (op >= 0xB8 && op <= 0xBF)
+      imm = (isRexW) ? 8 : immz;
+    else if (op >= 0xA0 && op <= 0xA3) // moffs
+      imm = (is64) ? ((isAddress16) ? 4 : 8) : ((isAddress16) ? 2 : 4);
+    else if (op == 0xC2 || op == 0xCA)
+      imm = 2;
+    else if (op == 0xC8)
+      imm = 3;
+    else if ((op == 0x9A || op == 0xEA) && !is64)
+      imm = immz + 2;
+    else if ((op == 0xF6 || op == 0xF7) && !((*p >> 3) & 6)) // test r/m, imm
+      imm = (op == 0xF6) ? 1 : immz;
+  }
+
+  if (hasModRm) {
+    auto modrm = *p++;
+    auto mod = modrm >> 6;
+    auto rm = modrm & 7;
+    if (mod != 3) {
+      if (isAddress16 && !is64)
+        p += (mod == 1) ? 1 : ((mod == 2 || (mod == 0 && rm == 6)) ? 2 : 0);
+      else {
+        if (rm == 4 && (*p++ & 7) == 5 && mod == 0) // SIB without base
+          p += 4;
+        p += (mod == 1) ? 1 : ((mod == 2 || (mod == 0 && rm == 5)) ? 4 : 0);
+      }
+    }
+  }
+
+  auto length = static_cast<size_t>(p - code) + imm;
+  return (length <= kMaxInstruction) ? length : 0;
+}
+
+/**
+  @brief  Gets length of whole instructions covering at least minSize bytes
+  @param  code    Function code
+  @param  minSize Bytes to be overwritten (e.g. by a jump)
+  @retval         Prologue length, 0 if an instruction could not be decoded
+**/
+inline size_t DecodePrologue(const Pointer& code, const size_t minSize) noexcept
+{
+  size_t length = 0;
+  while (length < minSize) {
+    auto size = DecodeLength(code.ToBytes() + length);
+    if (!size)
+      return 0;
+    length += size;
+  }
+  return length;
+}
+
+}
@@ -0,0 +1,273 @@
+/**
+  @brief     Image submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "process.h"
+
+namespace Memory
+{
+
+/**
+  @class Image
+  @brief Object used to read a PE image file without loading it
+
+  Maps the file read-only and reads sections, exports and relocations straight
+  from it, so images can be analysed offline. Only images of the same bitness
+  as the current process are read.
+**/
+class Image {
+public:
+  /**
+    @brief Image object constructor
+    @param filename Path to image file
+  **/
+  Image(const path& filename) :
+    file_(INVALID_HANDLE_VALUE), mapping_(nullptr), view_(nullptr), size_(0), ntHeaders_(nullptr)
+  {
+    file_ = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize;
+    if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &fileSize)) {
+      Close_();
+      _throws("Could not open image file");
+    }
+
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    mapping_ = (size_ >= sizeof(dosheader_t)) ? CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    if (mapping_ != nullptr)
+      view_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (view_ == nullptr) {
+      Close_();
+      _throws("Could not map image file");
+    }
+
+    auto dos = static_cast<const dosheader_t*>(view_);
+    auto nt = FromOffset_<ntheaders_t>(dos->e_lfanew, sizeof(ntheaders_t));
+    auto magic = (sizeof(pvoid_t) == 8) ? IMAGE_NT_OPTIONAL_HDR64_MAGIC : IMAGE_NT_OPTIONAL_HDR32_MAGIC;
+    if (dos->e_magic[0] != 'M' || dos->e_magic[1] != 'Z' || !nt || nt->Signature != IMAGE_NT_SIGNATURE ||
+        nt->OptionalHeader.Magic != magic) {
+      Close_();
+      _throws("Invalid image file");
+    }
+
+    auto first = reinterpret_cast<uintptr_t>(IMAGE_FIRST_SECTION(nt)) - reinterpret_cast<uintptr_t>(view_);
+    auto sections = FromOffset_<IMAGE_SECTION_HEADER>(first, nt->FileHeader.NumberOfSections * sizeof(IMAGE_SECTION_HEADER));
+    if (!sections) {
+      Close_();
+      _throws("Invalid image file");
+    }
+
+    ntHeaders_ = nt;
+    sections_ = { sections, nt->FileHeader.NumberOfSections };
+    IndexRelocations_();
+  }
+
+  Image(const Image&) = delete;
+  Image& operator=(const Image&) = delete;
+
+  /**
+    @brief Image object destructor
+  **/
+  ~Image()
+  {
+    Close_();
+  }
+
+  const ntheaders_t* GetNtHeaders() const noexcept
+  {
+    return ntHeaders_;
+  }
+
+  constexpr span<const IMAGE_SECTION_HEADER> GetSections() const noexcept
+  {
+    return sections_;
+  }
+
+  /**
+    @brief  Gets file size
+    @retval size_t Image file size
+  **/
+  constexpr size_t GetSize() const noexcept
+  {
+    return size_;
+  }
+
+  /**
+    @brief  Finds section containing RVA
+    @param  rva Address relative to image base
+    @retval     Section header, nullptr if not in any section
+  **/
+  const IMAGE_SECTION_HEADER* FindSection(const uint32_t rva) const noexcept
+  {
+    for (auto& section : sections_) {
+      if (rva >= section.VirtualAddress && rva - section.VirtualAddress < max<ulong_t>(section.Misc.VirtualSize, section.SizeOfRawData))
+        return &section;
+    }
+    return nullptr;
+  }
+
+  /**
+    @brief  Gets file data mapped at RVA
+    @param  rva  Address relative to image base
+    @param  size Amount of bytes that must be backed by file data
+    @retval      Pointer into mapped file, nullptr if not backed by file data
+  **/
+  Pointer FromRva(const uint32_t rva, const size_t size = 1) const noexcept
+  {
+    auto section = FindSection(rva);
+    if (!section || rva - section->VirtualAddress + size > section->SizeOfRawData)
+      return nullptr;
+    return FromOffset_<ubyte_t>(section->PointerToRawData + rva - section->VirtualAddress, size);
+  }
+
+  /**
+    @brief  Gets RVA of file data
+    @param  data Pointer into mapped file
+    @retval      Address relative to image base, 0 if not in any section
+  **/
+  uint32_t ToRva(const Pointer& data) const noexcept
+  {
+    auto offset = data.ToValue() - reinterpret_cast<uintptr_t>(view_);
+    for (auto& section : sections_) {
+      if (offset >= section.PointerToRawData && offset - section.PointerToRawData < section.SizeOfRawData)
+        return static_cast<uint32_t>(section.VirtualAddress + offset - section.PointerToRawData);
+    }
+    return 0;
+  }
+
+  /**
+    @brief  Finds exported function or variable by name
+    @param  name Export name
+    @retval      Export RVA, 0 if not exported or forwarded to another module
+  **/
+  uint32_t FindExport(const string_view& name) const noexcept
+  {
+    auto& entry = ntHeaders_->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    auto directory = FromRva(entry.VirtualAddress, sizeof(IMAGE_EXPORT_DIRECTORY)).ToObject<IMAGE_EXPORT_DIRECTORY>();
+    if (!entry.Size || !directory)
+      return 0;
+
+    auto names = FromRva(directory->AddressOfNames, directory->NumberOfNames * sizeof(ulong_t)).ToObject<ulong_t>();
+    auto ordinals = FromRva(directory->AddressOfNameOrdinals, directory->NumberOfNames * sizeof(ushort_t)).ToObject<ushort_t>();
+    auto functions = FromRva(directory->AddressOfFunctions, directory->NumberOfFunctions * sizeof(ulong_t)).ToObject<ulong_t>();
+    if (!names || !ordinals || !functions)
+      return 0;
+
+    // loader requires names to be sorted
+    auto found = lower_bound(names, names + directory->NumberOfNames, name, [&](const ulong_t rva, const string_view& name) {
+      return ReadString_(rva) < name;
+    });
+    if (found == names + directory->NumberOfNames || ReadString_(*found) != name)
+      return 0;
+
+    auto ordinal = ordinals[found - names];
+    if (ordinal >= directory->NumberOfFunctions)
+      return 0;
+    auto rva = functions[ordinal];
+    return (rva >= entry.VirtualAddress && rva - entry.VirtualAddress < entry.Size) ? 0 : rva;
+  }
+
+  /**
+    @brief  Gets addresses patched by the loader when image is not loaded at its preferred base
+    @retval RVAs of relocated pointers in ascending order
+  **/
+  constexpr const vector<uint32_t>& GetRelocations() const noexcept
+  {
+    return relocations_;
+  }
+
+  /**
+    @brief  Check if any byte of a range gets relocated
+    @param  rva  Address relative to image base
+    @param  size Amount of bytes
+    @retval bool Does range overlap a relocated pointer?
+  **/
+  bool IsRelocated(const uint32_t rva, const size_t size) const noexcept
+  {
+    auto found = lower_bound(relocations_.begin(), relocations_.end(), (rva >= sizeof(pvoid_t)) ? rva - sizeof(pvoid_t) + 1 : 0);
+    return found != relocations_.end() && *found < rva + size;
+  }
+
+private:
+  handle_t                         file_;      //!< Image file handle
+  handle_t                         mapping_;   //!< Image mapping handle
+  pvoid_t                          view_;      //!< Mapped file
+  size_t                           size_;      //!< File size
+  const ntheaders_t*               ntHeaders_;
+  span<const IMAGE_SECTION_HEADER> sections_;
+  vector<uint32_t>                 relocations_; //!< Sorted RVAs of relocated pointers
+
+  template<typename T>
+  T* FromOffset_(const uintptr_t offset, const size_t size) const noexcept
+  {
+    if (offset > size_ || size > size_ - offset)
+      return nullptr;
+    return Pointer(reinterpret_cast<uintptr_t>(view_) + offset).ToObject<T>();
+  }
+
+  string_view ReadString_(const uint32_t rva) const noexcept
+  {
+    auto section = FindSection(rva);
+    auto begin = FromRva(rva).ToObject<const char>();
+    if (!begin)
+      return string_view();
+    auto available = section->SizeOfRawData - (rva - section->VirtualAddress);
+    return string_view(begin, strnlen(begin, available));
+  }
+
+  void IndexRelocations_()
+  {
+    auto& entry = ntHeaders_->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_BASERELOC];
+    for (uint32_t offset = 0; offset + sizeof(IMAGE_BASE_RELOCATION) <= entry.Size;) {
+      auto block = FromRva(entry.VirtualAddress + offset, sizeof(IMAGE_BASE_RELOCATION)).ToObject<IMAGE_BASE_RELOCATION>();
+      if (!block || block->SizeOfBlock < sizeof(IMAGE_BASE_RELOCATION) || !FromRva(entry.VirtualAddress + offset, block->SizeOfBlock).ToVoid())
+        break;
+
+      auto count = (block->SizeOfBlock - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(ushort_t);
+      auto items = reinterpret_cast<const ushort_t*>(block + 1);
+      for (size_t i = 0; i < count; ++i) {
+        auto type = items[i] >> 12;
+        if (type == IMAGE_REL_BASED_HIGHLOW || type == IMAGE_REL_BASED_DIR64)
+          relocations_.push_back(block->VirtualAddress + (items[i] & 0xFFF));
+      }
+      offset += block->SizeOfBlock;
+    }
+    sort(relocations_.begin(), relocations_.end());
+  }
+
+  void Close_() noexcept
+  {
+    if (view_ != nullptr)
+      UnmapViewOfFile(view_);
+    if (mapping_ != nullptr)
+      CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE)
+      CloseHandle(file_);
+    view_ = nullptr;
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+  }
+};
+
+}
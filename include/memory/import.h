@@ -0,0 +1,156 @@
+/**
+  @brief     Import submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "process.h"
+#include "memorymap.h"
+#include "protection.h"
+
+namespace Memory
+{
+
+/**
+  @class ImportHook
+  @brief Object used to redirect imported function through import address tables
+
+  Swaps every import table slot bound to the original function, in every loaded
+  module, for a replacement. Callers pay no extra cost and original function
+  stays callable through GetOriginal.
+**/
+class ImportHook {
+public:
+  /**
+    @brief ImportHook object constructor
+    @param exporter    Module exporting function
+    @param name        Exported function name
+    @param replacement Function called instead
+    @param enable      Should slots be swapped right away?
+  **/
+  ImportHook(const Module& exporter, const string_view& name, const Pointer& replacement, const bool enable = true) :
+    ImportHook(exporter.FindExport(name), replacement, enable)
+  {
+  }
+
+  /**
+    @brief ImportHook object constructor
+    @param original    Function currently bound in import tables
+    @param replacement Function called instead
+    @param enable      Should slots be swapped right away?
+  **/
+  ImportHook(const Pointer& original, const Pointer& replacement, const bool enable = true) :
+    original_(original), replacement_(replacement)
+  {
+    if (!original_.ToVoid() || !replacement_.ToVoid())
+      _throws("Invalid arguments");
+    if (enable)
+      Enable();
+  }
+
+  /**
+    @brief ImportHook object destructor, restores swapped slots
+  **/
+  ~ImportHook()
+  {
+    Disable();
+  }
+
+  ImportHook(const ImportHook&) = delete;
+  ImportHook& operator=(const ImportHook&) = delete;
+
+  /**
+    @brief Swaps slots of every loaded module, modules loaded later need another call
+  **/
+  void Enable()
+  {
+    auto modules = Process().GetModules();
+    for (auto& module : *modules) {
+      auto slots = module.FindImportSlots(original_);
+      if (!slots.empty())
+        Swap_(slots, original_, replacement_);
+    }
+  }
+
+  /**
+    @brief Restores swapped slots, slots changed by someone else since are left alone
+  **/
+  void Disable()
+  {
+    for (auto& slots : tables_)
+      Swap_(slots, replacement_, original_);
+    tables_.clear();
+  }
+
+  /**
+    @brief  Check if any slot is swapped
+    @retval bool Is hook enabled?
+  **/
+  bool IsEnabled() const noexcept
+  {
+    return !tables_.empty();
+  }
+
+  /**
+    @brief  Gets amount of swapped slots
+    @retval size_t Swapped slots
+  **/
+  size_t GetSlotCount() const noexcept
+  {
+    size_t count = 0;
+    for (auto& slots : tables_)
+      count += slots.size();
+    return count;
+  }
+
+  /**
+    @brief  Gets original function, safe to call while hook is enabled
+    @retval Pointer Original function
+  **/
+  constexpr const Pointer& GetOriginal() const noexcept
+  {
+    return original_;
+  }
+
+private:
+  Pointer                 original_;
+  Pointer                 replacement_;
+  vector<vector<Pointer>> tables_; //!< Swapped slots, grouped by module
+
+  void Swap_(const vector<Pointer>& slots, const Pointer& from, const Pointer& to)
+  {
+    // one protection change for every slot of a module, table may share pages with code
+    auto size = slots.back() - slots.front() + sizeof(pvoid_t);
+    Protection protection(slots.front(), size, Protection::GetWritableMode(slots.front(), size));
+
+    vector<Pointer> swapped;
+    for (auto& slot : slots) {
+      auto previous = InterlockedCompareExchangePointer(slot.ToObject<pvoid_t>(), to.ToVoid(), from.ToVoid());
+      if (previous == from.ToVoid())
+        swapped.push_back(slot);
+    }
+    if (!swapped.empty() && to == replacement_)
+      tables_.push_back(move(swapped));
+  }
+};
+
+}
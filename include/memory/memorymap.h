@@ -0,0 +1,232 @@
+/**
+  @brief     MemoryMap submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "process.h"
+#include "protection.h"
+
+namespace Memory
+{
+
+/**
+  @class MemoryMap
+  @brief Snapshot of the current process address space
+
+  Keeps committed and reserved regions sorted by address, so the region
+  holding an address is found without a VirtualQuery call. Snapshot does
+  not follow later changes until refreshed.
+**/
+class MemoryMap {
+public:
+  /**
+    @struct Region
+    @brief  Run of pages sharing state, protection and type
+  **/
+  struct Region {
+    uintptr_t     base;    //!< First byte
+    size_t        size;    //!< Amount of bytes
+    ulong_t       state;   //!< MEM_COMMIT or MEM_RESERVE
+    ulong_t       protect; //!< Page protection, 0 if reserved
+    ulong_t       type;    //!< MEM_IMAGE, MEM_MAPPED or MEM_PRIVATE
+    const Module* module;  //!< Owning module, nullptr if none
+
+    constexpr bool IsCommitted() const noexcept
+    {
+      return state == MEM_COMMIT && !(protect & (PAGE_NOACCESS | PAGE_GUARD));
+    }
+
+    constexpr bool IsReadable() const noexcept
+    {
+      return IsCommitted() && (protect & 0xFF) != PAGE_EXECUTE;
+    }
+
+    constexpr bool IsWritable() const noexcept
+    {
+      return IsCommitted() && (protect & (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY));
+    }
+
+    constexpr bool IsExecutable() const noexcept
+    {
+      return IsCommitted() && (protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY));
+    }
+  };
+
+  /**
+    @brief MemoryMap object constructor, walks the whole address space
+  **/
+  MemoryMap()
+  {
+    Refresh();
+  }
+
+  /**
+    @brief MemoryMap object constructor, walks only the pages of a range
+    @note  Owning modules are not looked up
+    @param ptr  Range start
+    @param size Amount of bytes
+  **/
+  MemoryMap(const Pointer& ptr, const size_t size)
+  {
+    Query_(ptr.ToValue() & ~static_cast<uintptr_t>(0xFFF), ptr + size, regions_);
+  }
+
+  /**
+    @brief Walks the whole address space again
+  **/
+  void Refresh()
+  {
+    modules_ = Process().GetModules();
+    index_.clear();
+    for (auto& module : *modules_)
+      index_.push_back(&module);
+    sort(index_.begin(), index_.end(), [](const Module* l, const Module* r) {
+      return l->GetBaseAddress() < r->GetBaseAddress();
+    });
+    regions_.clear();
+    Query_(0, numeric_limits<uintptr_t>::max(), regions_);
+  }
+
+  /**
+    @brief Queries a range again, keeping every region outside of it
+    @note  Owning modules are looked up in the list taken by last full refresh
+    @param ptr  Range start
+    @param size Amount of bytes
+  **/
+  void Refresh(const Pointer& ptr, const size_t size)
+  {
+    vector<Region> queried;
+    auto begin = ptr.ToValue() & ~static_cast<uintptr_t>(0xFFF);
+    Query_(begin, ptr + size, queried);
+    auto end = (queried.empty()) ? ptr + size : queried.back().base + queried.back().size;
+
+    // clip regions crossing refreshed range and replace those inside it
+    auto first = lower_bound(regions_.begin(), regions_.end(), begin, [](const Region& region, const uintptr_t address) {
+      return region.base + region.size <= address;
+    });
+    auto last = first;
+    vector<Region> replaced;
+    if (first != regions_.end() && first->base < begin) {
+      replaced.push_back(*first);
+      replaced.back().size = begin - first->base;
+    }
+    for (; last != regions_.end() && last->base < end; ++last) {}
+    replaced.insert(replaced.end(), queried.begin(), queried.end());
+    if (last != first) {
+      auto& tail = *(last - 1);
+      if (tail.base + tail.size > end) {
+        replaced.push_back(tail);
+        replaced.back().size = tail.base + tail.size - end;
+        replaced.back().base = end;
+      }
+    }
+    auto at = regions_.erase(first, last);
+    regions_.insert(at, replaced.begin(), replaced.end());
+  }
+
+  /**
+    @brief  Finds region holding an address
+    @param  ptr Address
+    @retval     Region, nullptr if address is free
+  **/
+  const Region* Find(const Pointer& ptr) const noexcept
+  {
+    auto found = upper_bound(regions_.begin(), regions_.end(), ptr.ToValue(), [](const uintptr_t address, const Region& region) {
+      return address < region.base;
+    });
+    if (found == regions_.begin())
+      return nullptr;
+    --found;
+    return (ptr.ToValue() - found->base < found->size) ? &*found : nullptr;
+  }
+
+  /**
+    @brief  Check if a whole range is readable
+    @param  ptr  Range start
+    @param  size Amount of bytes
+    @retval bool Is every byte readable?
+  **/
+  bool IsReadable(const Pointer& ptr, const size_t size) const noexcept
+  {
+    for (auto address = ptr.ToValue(); address < ptr + size;) {
+      auto region = Find(address);
+      if (!region || !region->IsReadable())
+        return false;
+      address = region->base + region->size;
+    }
+    return true;
+  }
+
+  constexpr const vector<Region>& GetRegions() const noexcept
+  {
+    return regions_;
+  }
+
+private:
+  vector<Region>        regions_; //!< Sorted by address, never overlapping
+  Process::modules_t    modules_; //!< Keeps region modules alive
+  vector<const Module*> index_;   //!< Modules sorted by base address
+
+  void Query_(uintptr_t address, const uintptr_t end, vector<Region>& regions) const
+  {
+    meminfo_t info;
+    while (address < end && VirtualQuery(reinterpret_cast<pvoid_t>(address), &info, sizeof(info))) {
+      auto base = reinterpret_cast<uintptr_t>(info.BaseAddress);
+      if (info.State != MEM_FREE)
+        regions.push_back({ base, info.RegionSize, info.State, info.Protect, info.Type, FindModule_(base) });
+      if (base + info.RegionSize <= address)
+        break;
+      address = base + info.RegionSize;
+    }
+  }
+
+  const Module* FindModule_(const uintptr_t address) const noexcept
+  {
+    auto found = upper_bound(index_.begin(), index_.end(), address, [](const uintptr_t address, const Module* module) {
+      return module->GetBaseAddress() > address;
+    });
+    if (found == index_.begin())
+      return nullptr;
+    --found;
+    return (address - (*found)->GetBaseAddress().ToValue() < (*found)->GetSize()) ? *found : nullptr;
+  }
+};
+
+inline ulong_t Protection::GetWritableMode(const Pointer& ptr, const size_t size)
+{
+  return GetWritableMode(MemoryMap(ptr, size), ptr, size);
+}
+
+inline ulong_t Protection::GetWritableMode(const MemoryMap& map, const Pointer& ptr, const size_t size) noexcept
+{
+  constexpr ulong_t executable = PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+  for (auto address = ptr.ToValue(); address < ptr + size;) {
+    auto region = map.Find(address);
+    if (!region || (region->protect & executable))
+      return PAGE_EXECUTE_READWRITE;
+    address = region->base + region->size;
+  }
+  return PAGE_READWRITE;
+}
+
+}
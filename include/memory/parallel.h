@@ -0,0 +1,199 @@
+/**
+  @brief     Parallel submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+
+namespace Memory
+{
+
+inline size_t threadCount_ = max<size_t>(thread::hardware_concurrency(), 1); //!< Threads used by ParallelFor
+
+/**
+  @brief  Gets amount of threads used by ParallelFor
+  @retval Thread count, calling thread included
+**/
+inline size_t GetThreadCount() noexcept
+{
+  return threadCount_;
+}
+
+/**
+  @brief Sets amount of threads used by ParallelFor
+  @param count Thread count, calling thread included, 0 for one per core
+**/
+inline void SetThreadCount(const size_t count) noexcept
+{
+  threadCount_ = (count) ? count : max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+/**
+  @class WorkerPool
+  @brief Threads kept alive between ParallelFor calls
+
+  Workers are started on demand and wait for jobs in between. Each job also runs on
+  the thread posting it, so jobs posted from inside a task always make progress.
+
+  @note Pool is never destroyed, as joining from DllMain deadlocks on loader lock.
+        Call Stop before unloading, threads are terminated by the system on exit.
+**/
+class WorkerPool {
+public:
+  /**
+    @brief Job split into indexes claimed on demand
+  **/
+  struct Job {
+    atomic<size_t>         next = 0;
+    atomic<size_t>         done = 0;
+    atomic<size_t>         helpers = 0; //!< Workers that picked job
+    size_t                 count;
+    size_t                 maxHelpers;  //!< Workers allowed to pick job
+    function<void(size_t)> task;
+
+    /**
+      @brief Runs claimed indexes until every index is claimed
+      @note  A late worker finds every index claimed and leaves without touching task
+    **/
+    void Work()
+    {
+      for (auto i = next++; i < count; i = next++) {
+        task(i);
+        if (++done == count)
+          done.notify_all();
+      }
+    }
+  };
+
+  static WorkerPool& Get()
+  {
+    static auto pool = new WorkerPool();
+    return *pool;
+  }
+
+  /**
+    @brief Runs job on calling thread and up to maxHelpers workers, returning once every index is done
+    @param job Job to be run
+  **/
+  void Run(const shared_ptr<Job>& job)
+  {
+    {
+      lock_guard<mutex> lock(mutex_);
+      while (threads_.size() < job->maxHelpers)
+        threads_.emplace_back(&WorkerPool::Work_, this);
+      jobs_.push_back(job);
+    }
+    wake_.notify_all();
+
+    job->Work();
+    for (auto done = job->done.load(); done != job->count; done = job->done.load())
+      job->done.wait(done);
+
+    lock_guard<mutex> lock(mutex_);
+    erase(jobs_, job);
+  }
+
+  /**
+    @brief Stops and joins every worker, a later job starts them again
+    @note  Must not be called from DllMain
+  **/
+  void Stop()
+  {
+    vector<thread> threads;
+    {
+      lock_guard<mutex> lock(mutex_);
+      isStopping_ = true;
+      threads.swap(threads_);
+    }
+    wake_.notify_all();
+    for (auto& worker : threads)
+      worker.join();
+
+    lock_guard<mutex> lock(mutex_);
+    isStopping_ = false;
+  }
+
+  /**
+    @brief  Gets amount of started workers
+    @retval size_t Worker count
+  **/
+  size_t GetSize()
+  {
+    lock_guard<mutex> lock(mutex_);
+    return threads_.size();
+  }
+
+private:
+  mutex                     mutex_;
+  condition_variable        wake_;
+  vector<thread>            threads_;
+  vector<shared_ptr<Job>>   jobs_;               //!< Jobs still taking workers
+  bool                      isStopping_ = false;
+
+  WorkerPool() = default;
+
+  void Work_()
+  {
+    unique_lock<mutex> lock(mutex_);
+    for (;;) {
+      wake_.wait(lock, [this] { return isStopping_ || !jobs_.empty(); });
+      if (isStopping_)
+        return;
+
+      // job leaves queue once it has all the workers it may take
+      auto job = jobs_.front();
+      if (++job->helpers >= job->maxHelpers)
+        jobs_.erase(jobs_.begin());
+      lock.unlock();
+      job->Work();
+      lock.lock();
+    }
+  }
+};
+
+/**
+  @brief Runs task for every index in [0, count) on multiple threads, calling thread included
+  @param count Amount of tasks
+  @param task  Called with task index, must not throw
+  @note  Indexes are claimed on demand, so calling thread finishes all of them by itself when
+         workers can not start yet (e.g. while DllMain holds loader lock)
+**/
+template<class F>
+void ParallelFor(const size_t count, F&& task)
+{
+  if (!count)
+    return;
+
+  auto threads = min(GetThreadCount(), count);
+  if (threads <= 1) {
+    for (size_t i = 0; i < count; ++i)
+      task(i);
+    return;
+  }
+
+  auto job = make_shared<WorkerPool::Job>();
+  job->count = count;
+  job->maxHelpers = threads - 1;
+  job->task = task;
+  WorkerPool::Get().Run(job);
+}
+
+}
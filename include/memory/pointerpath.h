@@ -0,0 +1,162 @@
+/**
+  @brief     PointerPath submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "data.h"
+
+namespace Memory
+{
+
+/**
+  @class PointerPath
+  @brief Object used to follow a chain of pointers, e.g. [[[base+0x10]+0x48]+0x8]
+
+  Every offset but the last is added and dereferenced, the last one is only
+  added. Resolved links are cached, later resolves only check the root and
+  the last link are still the same instead of walking the whole chain, so
+  Reset must be called when a middle link may have changed.
+**/
+class PointerPath {
+public:
+  /**
+    @brief PointerPath object constructor
+    @param base    Address the chain starts from
+    @param offsets Offset of each link, at least one
+  **/
+  PointerPath(const Pointer& base, const vector<uintptr_t>& offsets) :
+    base_(base), offsets_(offsets), address_(nullptr)
+  {
+    if (offsets_.empty())
+      _throws("Invalid arguments");
+  }
+
+  PointerPath(const Pointer& base, const initializer_list<uintptr_t> offsets) :
+    PointerPath(base, vector<uintptr_t>(offsets))
+  {
+  }
+
+  /**
+    @brief  Resolves address at the end of the chain
+    @retval Pointer Resolved address, nullptr if a link is null or unreadable
+  **/
+  Pointer Resolve()
+  {
+    if (address_.ToVoid() && IsValid_())
+      return address_;
+    return Walk_(&PointerPath::Read_);
+  }
+
+  /**
+    @brief  Resolves chain into a typed object
+    @retval T* Object at the end of the chain, nullptr if a link is null or unreadable
+  **/
+  template<typename T>
+  T* Get()
+  {
+    return Resolve().ToObject<T>();
+  }
+
+  /**
+    @brief Drops cached links, next resolve walks the whole chain
+  **/
+  void Reset() noexcept
+  {
+    links_.clear();
+    address_ = nullptr;
+  }
+
+  constexpr const Pointer& GetBase() const noexcept
+  {
+    return base_;
+  }
+
+  constexpr const vector<uintptr_t>& GetOffsets() const noexcept
+  {
+    return offsets_;
+  }
+
+  /**
+    @brief Resolves many chains, reading links shared by several of them only once
+    @param paths Chains to be resolved
+  **/
+  static void ResolveAll(const span<PointerPath> paths)
+  {
+    unordered_map<uintptr_t, uintptr_t> read; //!< Links already read by this batch
+    for (auto& path : paths) {
+      if (path.address_.ToVoid() && path.IsValid_())
+        continue;
+      path.Walk_([&](const uintptr_t address) {
+        auto [link, isNew] = read.try_emplace(address, 0);
+        if (isNew)
+          link->second = Read_(address);
+        return link->second;
+      });
+    }
+  }
+
+private:
+  Pointer           base_;
+  vector<uintptr_t> offsets_;
+  vector<uintptr_t> links_;   //!< Value read at each dereferenced link
+  Pointer           address_; //!< Cached end of chain, nullptr if not resolved
+
+  bool IsValid_() const noexcept
+  {
+    if (links_.empty())
+      return true;
+
+    // root and last link catch most object replacements with two reads
+    auto last = links_.size() - 1;
+    if (Read_(base_ + offsets_[0]) != links_[0])
+      return false;
+    return !last || Read_(links_[last - 1] + offsets_[last]) == links_[last];
+  }
+
+  static uintptr_t Read_(const uintptr_t address) noexcept
+  {
+    // unreadable links resolve like null ones
+    uintptr_t link = 0;
+    SafeReadObject(address, link);
+    return link;
+  }
+
+  template<class F>
+  Pointer Walk_(F&& read)
+  {
+    Reset();
+    auto address = base_.ToValue();
+    for (size_t i = 0; i + 1 < offsets_.size(); ++i) {
+      address = read(address + offsets_[i]);
+      if (!address) {
+        links_.clear();
+        return nullptr;
+      }
+      links_.push_back(address);
+    }
+    address_ = address + offsets_.back();
+    return address_;
+  }
+};
+
+}
@@ -61,7 +61,8 @@ class Module {
   }
 
   Module(const path imageFile, const Pointer base) :
-    imageFile_(imageFile), baseAddress_(base), dosHeader_(nullptr), ntHeaders_(nullptr)
+    imageFile_(imageFile), baseAddress_(base), dosHeader_(nullptr), ntHeaders_(nullptr),
+    exports_(make_shared<Exports_>())
   {
     dosHeader_ = baseAddress_;
     ntHeaders_ = baseAddress_ + dosHeader_.ToObject<dosheader_t>()->e_lfanew;
@@ -73,11 +74,31 @@ class Module {
     return imageFile_;
   }
 
+  constexpr const path& GetImageFilename() const noexcept
+  {
+    return imageFile_;
+  }
+
   constexpr Pointer& GetBaseAddress() noexcept
   {
     return baseAddress_;
   }
 
+  constexpr const Pointer& GetBaseAddress() const noexcept
+  {
+    return baseAddress_;
+  }
+
+  const ntheaders_t* GetNtHeaders() const noexcept
+  {
+    return ntHeaders_.ToObject<ntheaders_t>();
+  }
+
+  const size_t GetSize() const noexcept
+  {
+    return ntHeaders_.ToObject<ntheaders_t>()->OptionalHeader.SizeOfImage;
+  }
+
   const Pointer GetEntryPoint() noexcept
   {
     return FindDynamicAddress(ntHeaders_.ToObject<ntheaders_t>()->OptionalHeader.AddressOfEntryPoint, true);
@@ -90,10 +111,58 @@ class Module {
     return (baseAddress_ == base) ? addr : baseAddress_ + (addr - base);
   }
 
+  /**
+    @brief  Finds exported function or variable by name, first call indexes export directory
+    @param  name Export name
+    @retval      Export address (forwarders resolved by loader), nullptr if not exported
+  **/
+  const Pointer FindExport(const string_view& name) const
+  {
+    if (!exports_)
+      return nullptr;
+    call_once(exports_->isIndexed, &Module::IndexExports_, this);
+
+    auto& slots = exports_->slots;
+    if (slots.empty())
+      return nullptr;
+
+    auto directory = GetExportDirectory_();
+    auto names = FromRva_<ulong_t>(directory->AddressOfNames);
+    auto hash = string_hash(name);
+    for (auto i = hash & (slots.size() - 1); slots[i].index != Exports_::kEmpty; i = (i + 1) & (slots.size() - 1)) {
+      if (slots[i].hash == hash && name == FromRva_<char>(names[slots[i].index]))
+        return ResolveExport_(directory, slots[i].index, name);
+    }
+    return nullptr;
+  }
+
+  /**
+    @brief  Finds import address table slots currently bound to an address
+    @param  address Imported function address
+    @retval         Slot addresses in ascending order
+  **/
+  vector<Pointer> FindImportSlots(const Pointer& address) const
+  {
+    vector<Pointer> slots;
+    auto& entry = ntHeaders_.ToObject<ntheaders_t>()->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
+    if (!entry.VirtualAddress || !entry.Size)
+      return slots;
+
+    for (auto descriptor = FromRva_<IMAGE_IMPORT_DESCRIPTOR>(entry.VirtualAddress); descriptor->Name; ++descriptor) {
+      for (auto thunk = FromRva_<pvoid_t>(descriptor->FirstThunk); *thunk; ++thunk) {
+        if (Pointer(*thunk) == address)
+          slots.push_back(Pointer::FromObject(thunk));
+      }
+    }
+    sort(slots.begin(), slots.end());
+    return slots;
+  }
+
   void operator=(const Module& eq)
   {
     imageFile_ = eq.imageFile_;
     baseAddress_ = eq.baseAddress_;
+    exports_ = eq.exports_;
     dosHeader_ = baseAddress_;
     ntHeaders_ = baseAddress_ + dosHeader_.ToObject<dosheader_t>()->e_lfanew;
     isDll_ = ntHeaders_.ToObject<ntheaders_t>()->FileHeader.Characteristics & IMAGE_FILE_DLL;
@@ -108,21 +177,85 @@ class Module {
   const uintptr_t dllStaticBase_ = 0x10000000u;
 #endif
 
-  path    imageFile_;
-  Pointer baseAddress_;
-  Pointer dosHeader_;
-  Pointer ntHeaders_;
-  bool    isDll_;
+  /**
+    @brief Open addressing hash index of exported names, shared by module copies
+  **/
+  struct Exports_ {
+    static constexpr uint32_t kEmpty = numeric_limits<uint32_t>::max();
+
+    struct Slot {
+      uint64_t hash;  //!< Export name hash
+      uint32_t index; //!< Index in export name table
+    };
+
+    once_flag    isIndexed;
+    vector<Slot> slots; //!< Power of two sized, at most half full
+  };
+
+  path                 imageFile_;
+  Pointer              baseAddress_;
+  Pointer              dosHeader_;
+  Pointer              ntHeaders_;
+  bool                 isDll_;
+  shared_ptr<Exports_> exports_;
+
+  template<typename T>
+  T* FromRva_(const uintptr_t rva) const noexcept
+  {
+    return Pointer(baseAddress_ + rva).ToObject<T>();
+  }
+
+  const IMAGE_EXPORT_DIRECTORY* GetExportDirectory_() const noexcept
+  {
+    auto& entry = ntHeaders_.ToObject<ntheaders_t>()->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    return (entry.VirtualAddress && entry.Size) ? FromRva_<IMAGE_EXPORT_DIRECTORY>(entry.VirtualAddress) : nullptr;
+  }
+
+  void IndexExports_() const
+  {
+    auto directory = GetExportDirectory_();
+    if (!directory || !directory->NumberOfNames)
+      return;
+
+    size_t capacity = 2;
+    while (capacity < directory->NumberOfNames * 2u)
+      capacity <<= 1;
+
+    auto& slots = exports_->slots;
+    slots.assign(capacity, { 0, Exports_::kEmpty });
+    auto names = FromRva_<ulong_t>(directory->AddressOfNames);
+    for (uint32_t index = 0; index < directory->NumberOfNames; ++index) {
+      auto hash = string_hash(FromRva_<char>(names[index]));
+      auto i = hash & (capacity - 1);
+      while (slots[i].index != Exports_::kEmpty)
+        i = (i + 1) & (capacity - 1);
+      slots[i] = { hash, index };
+    }
+  }
+
+  const Pointer ResolveExport_(const IMAGE_EXPORT_DIRECTORY* directory, const uint32_t index, const string_view& name) const
+  {
+    auto ordinals = FromRva_<ushort_t>(directory->AddressOfNameOrdinals);
+    auto functions = FromRva_<ulong_t>(directory->AddressOfFunctions);
+    auto rva = functions[ordinals[index]];
+
+    // forwarded exports point to "module.function" strings inside export directory
+    auto& entry = ntHeaders_.ToObject<ntheaders_t>()->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+    if (rva >= entry.VirtualAddress && rva < entry.VirtualAddress + entry.Size)
+      return GetProcAddress(baseAddress_.ToAny<hmodule_t>(), string(name).c_str());
+    return baseAddress_ + rva;
+  }
 };
 
+/**
+  @brief Loaded modules of current process
+**/
 class Process {
 public:
-  Process()
-  {
-    imageFile_.resize(_staticSize);
-    GetModuleFileNameW(nullptr, imageFile_.data(), _staticSize);
+  using modules_t = shared_ptr<const vector<Module>>;
 
-    EnumerateLoadedModules();
+  Process() : base_(GetImageFilename_(), reinterpret_cast<pvoid_t>(GetModuleHandleW(nullptr)))
+  {
   }
 
   constexpr Module& GetBaseModule() noexcept
@@ -130,37 +263,128 @@ class Process {
     return base_;
   }
 
-  void EnumerateLoadedModules()
+  /**
+    @brief  Gets loaded modules, enumerated only after a module was loaded or unloaded
+    @retval Immutable list of modules, safe to keep while modules change
+  **/
+  modules_t GetModules()
   {
-    auto mi = make_unique<meminfo_t>();
-    VirtualQuery(nullptr, &*mi, sizeof(*mi));
+    static Notifier_ notifier;
 
-    Pointer currAddr = nullptr;
+    auto generation = generation_.load();
+    {
+      lock_guard<mutex> lock(mutex_);
+      if (modules_ && notifier.IsActive() && modulesGeneration_ == generation)
+        return modules_;
+    }
+
+    // snapshot waits for loader lock, which notifications hold, so it is taken unlocked;
+    // a list enumerated before a later one was published is returned but not cached
+    auto modules = EnumerateLoadedModules();
+    lock_guard<mutex> lock(mutex_);
+    if (!modules_ || generation >= modulesGeneration_) {
+      modules_ = modules;
+      modulesGeneration_ = generation;
+    }
+    return modules;
+  }
+
+  /**
+    @brief  Finds loaded module by its file name (e.g. kernel32.dll)
+    @param  name Module file name, compared case-insensitively
+    @retval      Module
+  **/
+  Module FindModule(const wstring_view& name)
+  {
+    auto modules = GetModules();
+    for (auto& module : *modules) {
+      auto filename = module.GetImageFilename().filename().wstring();
+      if (filename.size() == name.size() && !_wcsnicmp(filename.data(), name.data(), name.size()))
+        return module;
+    }
+    _throws("Could not find loaded module");
+  }
+
+  /**
+    @brief  Enumerates modules from the loader list, regardless of cache
+    @retval Immutable list of modules
+  **/
+  static modules_t EnumerateLoadedModules()
+  {
+    handle_t snapshot;
     do {
-      Protection protection(mi->AllocationBase, mi->RegionSize);
-      currAddr += mi->RegionSize;
-
-      if (protection.GetOldMode() == PAGE_NOACCESS)
-        continue;
-      if (mi->AllocationBase == mi->BaseAddress && mi->Protect == PAGE_READONLY) {
-        wstring name;
-        name.resize(_staticSize);
-        GetModuleFileNameW(reinterpret_cast<hmodule_t>(mi->BaseAddress), name.data(), _staticSize);
-        modules_.emplace_back(name, mi->BaseAddress);
-
-        if (imageFile_ == name)
-          base_ = modules_.back();
-      }
-    } while (VirtualQuery(&currAddr, &*mi, sizeof(*mi)));
+      snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, 0);
+    } while (snapshot == INVALID_HANDLE_VALUE && GetLastError() == ERROR_BAD_LENGTH);
+    if (snapshot == INVALID_HANDLE_VALUE)
+      _throws("Could not snapshot loaded modules");
 
-    if (base_.GetBaseAddress().ToVoid() == nullptr)
-      _throws("Could not find process base module");
+    auto modules = make_shared<vector<Module>>();
+    MODULEENTRY32W entry = {};
+    entry.dwSize = sizeof(entry);
+    for (auto found = Module32FirstW(snapshot, &entry); found; found = Module32NextW(snapshot, &entry))
+      modules->emplace_back(entry.szExePath, entry.modBaseAddr);
+
+    CloseHandle(snapshot);
+    return modules;
   }
 
 private:
-  wstring        imageFile_;
-  Module         base_;
-  vector<Module> modules_;
-};
+  /**
+    @brief Marks module cache as stale whenever loader maps or unmaps a module
+  **/
+  class Notifier_ {
+  public:
+    Notifier_() : cookie_(nullptr)
+    {
+      // not exported by import libraries, resolved at runtime
+      auto ntdll = GetModuleHandleW(L"ntdll.dll");
+      if (!ntdll)
+        return;
+      auto reg = reinterpret_cast<register_t>(GetProcAddress(ntdll, "LdrRegisterDllNotification"));
+      if (reg && reg(0, &Notifier_::OnNotification_, nullptr, &cookie_) < 0)
+        cookie_ = nullptr;
+    }
+
+    ~Notifier_()
+    {
+      if (!cookie_)
+        return;
+      auto unreg = reinterpret_cast<unregister_t>(GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "LdrUnregisterDllNotification"));
+      if (unreg)
+        unreg(cookie_);
+    }
+
+    constexpr bool IsActive() const noexcept
+    {
+      return cookie_ != nullptr;
+    }
 
+  private:
+    using callback_t = void(NTAPI*)(ulong_t, const void*, pvoid_t);
+    using register_t = long(NTAPI*)(ulong_t, callback_t, pvoid_t, pvoid_t*);
+    using unregister_t = long(NTAPI*)(pvoid_t);
+
+    pvoid_t cookie_;
+
+    static void NTAPI OnNotification_(ulong_t, const void*, pvoid_t)
+    {
+      // runs under loader lock, only flag the cache
+      ++generation_;
+    }
+  };
+
+  Module base_;
+
+  static inline mutex          mutex_;
+  static inline modules_t      modules_;
+  static inline size_t         modulesGeneration_ = 0; //!< Generation modules_ was enumerated at
+  static inline atomic<size_t> generation_ = 0;        //!< Bumped whenever a module is loaded or unloaded
+
+  static path GetImageFilename_()
+  {
+    wstring name(_staticSize, L'\0');
+    name.resize(GetModuleFileNameW(nullptr, name.data(), _staticSize));
+    return name;
+  }
+};
 }
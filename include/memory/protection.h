@@ -29,6 +29,8 @@
 namespace Memory
 {
 
+class MemoryMap;
+
 /**
   @class Protection
   @brief Object used to change memory virtual protection
@@ -39,11 +41,10 @@ namespace Memory
 class Protection {
 public:
   Protection(const Pointer& ptr, const size_t& size, const ulong_t& mode = PAGE_EXECUTE_READWRITE) :
-    ptr_(ptr), size_(size), mode_(mode), oldMode_(0)
+    ptr_(ptr), mode_(mode), oldMode_(0), size_(size), isEnabled_(false)
   {
     if (size_)
       isEnabled_ = VirtualProtect(&ptr_, size_, mode_, &oldMode_);
-    isEnabled_ = false;
   };
 
   /**
@@ -82,6 +83,25 @@ class Protection {
     return mode_;
   }
 
+  /**
+    @brief  Gets writable mode keeping execute access of a range
+    @note   Defined by memorymap.h, snapshots only the given range
+    @param  ptr  Range start
+    @param  size Range size
+    @retval ulong_t PAGE_READWRITE if no page is executable, otherwise PAGE_EXECUTE_READWRITE
+  **/
+  static ulong_t GetWritableMode(const Pointer& ptr, const size_t size);
+
+  /**
+    @brief  Gets writable mode keeping execute access of a range, without querying pages
+    @note   Defined by memorymap.h
+    @param  map  Snapshot holding the range
+    @param  ptr  Range start
+    @param  size Range size
+    @retval ulong_t PAGE_READWRITE if no page is executable, otherwise PAGE_EXECUTE_READWRITE
+  **/
+  static ulong_t GetWritableMode(const MemoryMap& map, const Pointer& ptr, const size_t size) noexcept;
+
 private:
   Pointer ptr_;
   ulong_t mode_;      //!< Current mode
@@ -0,0 +1,294 @@
+/**
+  @brief     Remote submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+
+namespace Memory
+{
+
+/**
+  @class RemoteProcess
+  @brief Object used to read and write memory of another process
+**/
+class RemoteProcess {
+public:
+  /**
+    @class Batch
+    @brief Object used to queue many reads and writes, done with as few calls as possible
+
+    Requests are sorted by address. Reads close to each other are merged into a
+    single call and scattered from a shared buffer. Contiguous writes are
+    gathered into a single call.
+  **/
+  class Batch {
+  public:
+    static constexpr size_t kMaxGap = 0x1000;   //!< Largest unrequested gap read to merge two reads
+    static constexpr size_t kMaxSpan = 0x10000; //!< Largest merged read
+
+    Batch() : calls_(0)
+    {
+    }
+
+    /**
+      @brief Queues read
+      @param address Remote address
+      @param out     Destination buffer, must stay valid until executed
+      @param size    Amount of bytes
+    **/
+    void Read(const Pointer& address, void* out, const size_t size)
+    {
+      reads_.push_back({ address.ToValue(), size, static_cast<ubyte_t*>(out) });
+    }
+
+    template<class T>
+    void ReadObject(const Pointer& address, T& out)
+    {
+      Read(address, &out, sizeof(T));
+    }
+
+    /**
+      @brief Queues write, bytes are copied right away
+      @param address Remote address
+      @param in      Source bytes
+      @param size    Amount of bytes
+    **/
+    void Write(const Pointer& address, const void* in, const size_t size)
+    {
+      writes_.push_back({ address.ToValue(), size, nullptr, vector<ubyte_t>(static_cast<const ubyte_t*>(in), static_cast<const ubyte_t*>(in) + size) });
+    }
+
+    template<class T>
+    void WriteObject(const Pointer& address, const T& value)
+    {
+      Write(address, &value, sizeof(T));
+    }
+
+    /**
+      @brief  Does queued writes and then queued reads, leaving batch empty
+      @param  process Process memory belongs to
+      @retval size_t  Amount of requests done
+    **/
+    size_t Execute(const RemoteProcess& process)
+    {
+      calls_ = 0;
+      auto done = Execute_(process, writes_, 0, numeric_limits<size_t>::max()) + Execute_(process, reads_, kMaxGap, kMaxSpan);
+      reads_.clear();
+      writes_.clear();
+      return done;
+    }
+
+    /**
+      @brief  Gets amount of queued requests
+      @retval size_t Queued reads and writes
+    **/
+    size_t Size() const noexcept
+    {
+      return reads_.size() + writes_.size();
+    }
+
+    /**
+      @brief  Gets amount of calls into the other process made by last execution
+      @retval size_t Calls made
+    **/
+    constexpr size_t GetCalls() const noexcept
+    {
+      return calls_;
+    }
+
+  private:
+    struct Request_ {
+      uintptr_t       address;
+      size_t          size;
+      ubyte_t*        out;   //!< Read destination, nullptr for writes
+      vector<ubyte_t> bytes; //!< Write source
+    };
+
+    vector<Request_> reads_;
+    vector<Request_> writes_;
+    vector<ubyte_t>  buffer_; //!< Merged request bytes
+    size_t           calls_;  //!< Calls made by last execution
+
+    size_t Execute_(const RemoteProcess& process, vector<Request_>& requests, const size_t maxGap, const size_t maxSpan)
+    {
+      stable_sort(requests.begin(), requests.end(), [](const Request_& l, const Request_& r) {
+        return l.address < r.address;
+      });
+
+      size_t done = 0;
+      for (size_t first = 0, last; first < requests.size(); first = last) {
+        // merge following requests while span stays small
+        auto begin = requests[first].address;
+        auto end = begin + requests[first].size;
+        for (last = first + 1; last < requests.size(); ++last) {
+          auto& next = requests[last];
+          auto nextEnd = max<uintptr_t>(end, next.address + next.size);
+          if (next.address > end + maxGap || nextEnd - begin > max<size_t>(maxSpan, requests[first].size))
+            break;
+          end = nextEnd;
+        }
+
+        auto isWrite = !requests[first].out;
+        if (last - first == 1) {
+          auto& request = requests[first];
+          ++calls_;
+          auto isDone = isWrite ? process.Write(request.address, request.bytes.data(), request.size) :
+                                  process.Read(request.address, request.out, request.size);
+          done += isDone;
+          continue;
+        }
+
+        buffer_.resize(end - begin);
+        if (isWrite) {
+          for (auto i = first; i < last; ++i)
+            memcpy(buffer_.data() + requests[i].address - begin, requests[i].bytes.data(), requests[i].size);
+        }
+        ++calls_;
+        auto isDone = isWrite ? process.Write(begin, buffer_.data(), buffer_.size()) :
+                                process.Read(begin, buffer_.data(), buffer_.size());
+        if (isDone) {
+          if (!isWrite) {
+            for (auto i = first; i < last; ++i)
+              memcpy(requests[i].out, buffer_.data() + requests[i].address - begin, requests[i].size);
+          }
+          done += last - first;
+          continue;
+        }
+
+        // merged span crosses unreadable memory, retry requests one by one
+        for (auto i = first; i < last; ++i) {
+          auto& request = requests[i];
+          ++calls_;
+          done += isWrite ? process.Write(request.address, request.bytes.data(), request.size) :
+                            process.Read(request.address, request.out, request.size);
+        }
+      }
+      return done;
+    }
+  };
+
+  /**
+    @brief RemoteProcess object constructor
+    @param processId Process identifier
+    @param access    Requested access rights
+  **/
+  RemoteProcess(const ulong_t processId,
+                const ulong_t access = PROCESS_VM_READ | PROCESS_VM_WRITE | PROCESS_VM_OPERATION | PROCESS_QUERY_INFORMATION) :
+    id_(processId), handle_(OpenProcess(access, false, processId))
+  {
+    if (handle_ == nullptr)
+      _throws("Could not open process");
+  }
+
+  /**
+    @brief RemoteProcess object destructor
+  **/
+  ~RemoteProcess()
+  {
+    CloseHandle(handle_);
+  }
+
+  RemoteProcess(const RemoteProcess&) = delete;
+  RemoteProcess& operator=(const RemoteProcess&) = delete;
+
+  constexpr ulong_t GetId() const noexcept
+  {
+    return id_;
+  }
+
+  constexpr handle_t GetHandle() const noexcept
+  {
+    return handle_;
+  }
+
+  /**
+    @brief  Reads remote memory
+    @param  address Remote address
+    @param  out     Destination buffer
+    @param  size    Amount of bytes
+    @retval bool    Were all bytes read?
+  **/
+  bool Read(const Pointer& address, void* out, const size_t size) const noexcept
+  {
+    SIZE_T read = 0;
+    return !size || (ReadProcessMemory(handle_, address.ToVoid(), out, size, &read) && read == size);
+  }
+
+  /**
+    @brief  Writes remote memory
+    @param  address Remote address
+    @param  in      Source bytes
+    @param  size    Amount of bytes
+    @retval bool    Were all bytes written?
+  **/
+  bool Write(const Pointer& address, const void* in, const size_t size) const noexcept
+  {
+    SIZE_T written = 0;
+    return !size || (WriteProcessMemory(handle_, address.ToVoid(), in, size, &written) && written == size);
+  }
+
+  template<class T>
+  bool ReadObject(const Pointer& address, T& value) const noexcept
+  {
+    return Read(address, &value, sizeof(T));
+  }
+
+  template<class T>
+  bool WriteObject(const Pointer& address, const T& value) const noexcept
+  {
+    return Write(address, &value, sizeof(T));
+  }
+
+  /**
+    @brief  Finds base address of a module loaded by the process
+    @param  name Module file name, compared case-insensitively
+    @retval      Module base address, nullptr if not loaded
+  **/
+  Pointer FindModule(const wstring_view& name) const
+  {
+    handle_t snapshot;
+    do {
+      snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, id_);
+    } while (snapshot == INVALID_HANDLE_VALUE && GetLastError() == ERROR_BAD_LENGTH);
+    if (snapshot == INVALID_HANDLE_VALUE)
+      _throws("Could not snapshot loaded modules");
+
+    Pointer base = nullptr;
+    MODULEENTRY32W entry = {};
+    entry.dwSize = sizeof(entry);
+    for (auto found = Module32FirstW(snapshot, &entry); found; found = Module32NextW(snapshot, &entry)) {
+      if (wcslen(entry.szModule) == name.size() && !_wcsnicmp(entry.szModule, name.data(), name.size())) {
+        base = entry.modBaseAddr;
+        break;
+      }
+    }
+    CloseHandle(snapshot);
+    return base;
+  }
+
+private:
+  ulong_t  id_;
+  handle_t handle_;
+};
+
+}
@@ -0,0 +1,601 @@
+/**
+  @brief     Scanner submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "process.h"
+#include "image.h"
+#include "memorymap.h"
+#include "parallel.h"
+
+namespace Memory
+{
+
+/**
+  @brief Byte signature with wildcards, parsed from IDA-style text (e.g. "48 8B ?? ?? 4? 05")
+**/
+class Pattern {
+public:
+  Pattern(const string_view& signature)
+  {
+    for (size_t pos = 0; pos < signature.size();) {
+      if (isspace(static_cast<ubyte_t>(signature[pos]))) {
+        ++pos;
+        continue;
+      }
+      auto end = _min(signature.find(' ', pos), signature.size());
+      auto token = signature.substr(pos, end - pos);
+      pos = end;
+
+      if (token == "?" || token == "??") {
+        bytes_.push_back(0);
+        mask_.push_back(0);
+        continue;
+      }
+      if (token.size() != 2)
+        _throws("Invalid pattern token");
+
+      ubyte_t byte = 0;
+      ubyte_t mask = 0;
+      for (auto ch : token) {
+        byte <<= 4;
+        mask <<= 4;
+        if (ch == '?')
+          continue;
+        if (!isxdigit(static_cast<ubyte_t>(ch)))
+          _throws("Invalid pattern token");
+        byte |= static_cast<ubyte_t>(isdigit(ch) ? ch - '0' : (tolower(ch) - 'a' + 10));
+        mask |= 0xF;
+      }
+      bytes_.push_back(byte);
+      mask_.push_back(mask);
+    }
+
+    // anchor on the two rarest exact bytes, both must match before verifying the rest
+    anchor_ = Size();
+    for (size_t i = 0; i < Size(); ++i) {
+      if (mask_[i] == 0xFF && (anchor_ == Size() || Rarity(bytes_[i]) > Rarity(bytes_[anchor_])))
+        anchor_ = i;
+    }
+    if (anchor_ == Size())
+      _throws("Pattern needs at least one exact byte");
+
+    second_ = anchor_;
+    for (size_t i = 0; i < Size(); ++i) {
+      if (i != anchor_ && mask_[i] == 0xFF && (second_ == anchor_ || Rarity(bytes_[i]) > Rarity(bytes_[second_])))
+        second_ = i;
+    }
+  }
+
+  constexpr size_t Size() const noexcept
+  {
+    return bytes_.size();
+  }
+
+  constexpr const ubyte_t* GetBytes() const noexcept
+  {
+    return bytes_.data();
+  }
+
+  constexpr const ubyte_t* GetMask() const noexcept
+  {
+    return mask_.data();
+  }
+
+  /**
+    @brief  Gets offsets of exact bytes used to find match candidates
+    @retval Pair of offsets, equal when pattern has a single exact byte
+  **/
+  constexpr pair<size_t, size_t> GetAnchors() const noexcept
+  {
+    return { anchor_, second_ };
+  }
+
+  /**
+    @brief  Compares pattern against memory
+    @param  data Memory with at least Size() readable bytes
+    @retval      Whether every non-wildcard bit matches
+  **/
+  bool Match(const ubyte_t* data) const noexcept
+  {
+    for (size_t i = 0; i < Size(); ++i) {
+      if ((data[i] & mask_[i]) != bytes_[i])
+        return false;
+    }
+    return true;
+  }
+
+  /**
+    @brief  Ranks byte by how rarely it shows up in x86 code
+    @param  byte Byte to be ranked
+    @retval      Higher is rarer
+  **/
+  static constexpr int Rarity(const ubyte_t byte) noexcept
+  {
+    // padding, prefixes and the most frequent x86 opcodes
+    switch (byte) {
+    case 0x00: case 0xFF: case 0xCC: case 0x90:
+      return 0;
+    case 0x48: case 0x89: case 0x8B: case 0x0F: case 0xE8: case 0x4C: case 0x24: case 0x83:
+      return 1;
+    default:
+      return 2;
+    }
+  }
+
+private:
+  vector<ubyte_t> bytes_;  //!< Pattern bytes, wildcard bits cleared
+  vector<ubyte_t> mask_;   //!< Set bits must match
+  size_t          anchor_; //!< Offset of rarest exact byte
+  size_t          second_; //!< Offset of second rarest exact byte
+};
+
+/**
+  @brief Set of patterns compiled for finding all of them in a single pass
+**/
+class PatternSet {
+public:
+  PatternSet(vector<Pattern> patterns) : patterns_(move(patterns)), maxSize_(1), bitmap_()
+  {
+    for (uint32_t index = 0; index < patterns_.size(); ++index) {
+      auto& pattern = patterns_[index];
+      maxSize_ = _max(maxSize_, pattern.Size());
+      if (pattern.Size() == 1) {
+        singles_.push_back(index);
+        AddKeys_(index, 0, { pattern.GetBytes()[0], 0 }, { pattern.GetMask()[0], 0 });
+        continue;
+      }
+
+      // anchor on the adjacent byte pair with fewest possible values, then rarest
+      size_t best = 0;
+      auto bestScore = numeric_limits<int>::min();
+      for (size_t i = 0; i + 1 < pattern.Size(); ++i) {
+        auto mask = pattern.GetMask();
+        auto score = -64 * (popcount(static_cast<ubyte_t>(~mask[i])) + popcount(static_cast<ubyte_t>(~mask[i + 1])))
+                   + Pattern::Rarity(pattern.GetBytes()[i]) + Pattern::Rarity(pattern.GetBytes()[i + 1]);
+        if (score > bestScore) {
+          best = i;
+          bestScore = score;
+        }
+      }
+      AddKeys_(index, static_cast<uint32_t>(best), { pattern.GetBytes()[best], pattern.GetBytes()[best + 1] },
+               { pattern.GetMask()[best], pattern.GetMask()[best + 1] });
+    }
+    sort(entries_.begin(), entries_.end(), [](const Entry_& l, const Entry_& r) {
+      return l.key < r.key;
+    });
+  }
+
+  size_t Size() const noexcept
+  {
+    return patterns_.size();
+  }
+
+  /**
+    @brief  Gets size of longest pattern
+    @retval Pattern size, at least 1
+  **/
+  size_t MaxSize() const noexcept
+  {
+    return maxSize_;
+  }
+
+  const Pattern& operator[](const size_t index) const
+  {
+    return patterns_.at(index);
+  }
+
+  /**
+    @brief  Finds every pattern of set in a single pass
+    @param  data    Memory to be scanned
+    @param  size    Amount of bytes to be scanned
+    @param  onMatch Called with pattern index and match address, returns false to stop
+    @retval         False if stopped by onMatch
+    @note   Matches of each pattern are reported in ascending order
+  **/
+  template<class F>
+  bool Scan(const ubyte_t* data, const size_t size, F&& onMatch) const
+  {
+    for (size_t pos = 0; pos + 1 < size; ++pos) {
+      auto key = static_cast<ushort_t>(data[pos] | (data[pos + 1] << 8));
+      if (!(bitmap_[key >> 6] & (1ull << (key & 63))))
+        continue;
+
+      auto entry = lower_bound(entries_.begin(), entries_.end(), key, [](const Entry_& l, const ushort_t r) {
+        return l.key < r;
+      });
+      for (; entry != entries_.end() && entry->key == key; ++entry) {
+        auto& pattern = patterns_[entry->pattern];
+        if (entry->offset > pos || pos - entry->offset + pattern.Size() > size)
+          continue;
+
+        auto match = data + pos - entry->offset;
+        if (pattern.Match(match) && !onMatch(entry->pattern, match))
+          return false;
+      }
+    }
+
+    // single byte patterns have no pair to anchor on at the very last byte
+    for (auto index : singles_) {
+      if (size && patterns_[index].Match(data + size - 1) && !onMatch(index, data + size - 1))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  struct Entry_ {
+    ushort_t key;     //!< Anchor byte pair, first byte in low bits
+    uint32_t offset;  //!< Anchor offset in pattern
+    uint32_t pattern; //!< Pattern index
+  };
+
+  vector<Pattern>  patterns_;
+  size_t           maxSize_;  //!< Longest pattern size
+  vector<Entry_>   entries_;  //!< Sorted by key
+  vector<uint32_t> singles_;  //!< Indexes of single byte patterns
+  uint64_t         bitmap_[0x10000 / 64]; //!< Set for every key with entries
+
+  void AddKeys_(const uint32_t pattern, const uint32_t offset, const pair<ubyte_t, ubyte_t>& bytes, const pair<ubyte_t, ubyte_t>& mask)
+  {
+    // wildcard bits expand into every value they may take
+    for (uint32_t first = 0; first < 0x100; ++first) {
+      if ((first & mask.first) != bytes.first)
+        continue;
+      for (uint32_t second = 0; second < 0x100; ++second) {
+        if ((second & mask.second) != bytes.second)
+          continue;
+        auto key = static_cast<ushort_t>(first | (second << 8));
+        bitmap_[key >> 6] |= 1ull << (key & 63);
+        entries_.push_back({ key, offset, pattern });
+      }
+    }
+  }
+};
+
+/**
+  @brief Instruction sets used by Scanner
+**/
+enum class Isa {
+  Scalar,
+  Sse2,
+  Avx2
+};
+
+/**
+  @brief Finds patterns in executable sections of a module or image file, executable regions or a memory range
+**/
+class Scanner {
+public:
+  Scanner(const Module& module)
+  {
+    auto nt = module.GetNtHeaders();
+    auto section = IMAGE_FIRST_SECTION(nt);
+    for (auto i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+      if (section->Characteristics & IMAGE_SCN_MEM_EXECUTE)
+        ranges_.emplace_back((module.GetBaseAddress() + section->VirtualAddress), section->Misc.VirtualSize);
+    }
+  }
+
+  Scanner(const Image& image)
+  {
+    for (auto& section : image.GetSections()) {
+      auto size = min<size_t>(section.Misc.VirtualSize, section.SizeOfRawData);
+      auto data = image.FromRva(section.VirtualAddress, size);
+      if ((section.Characteristics & IMAGE_SCN_MEM_EXECUTE) && data.ToVoid())
+        ranges_.emplace_back(data.ToValue(), size);
+    }
+  }
+
+  Scanner(const MemoryMap& map)
+  {
+    // also covers code outside of modules, e.g. generated at runtime
+    for (auto& region : map.GetRegions()) {
+      if (region.IsExecutable() && region.IsReadable())
+        ranges_.emplace_back(region.base, region.size);
+    }
+  }
+
+  Scanner(const Pointer& begin, const size_t size)
+  {
+    ranges_.emplace_back(begin.ToValue(), size);
+  }
+
+  /**
+    @brief  Finds first match of pattern
+    @param  pattern Pattern to be found
+    @retval         Match address, nullptr if not found
+  **/
+  const Pointer Find(const Pattern& pattern) const
+  {
+    auto chunks = Split_(pattern.Size() - 1);
+    vector<const ubyte_t*> found(chunks.size(), nullptr);
+    atomic<size_t> first = chunks.size(); //!< Lowest chunk with a match so far
+
+    ParallelFor(chunks.size(), [&](const size_t i) {
+      if (i > first)
+        return;
+      auto& chunk = chunks[i];
+      Scan(chunk.begin, chunk.readable, pattern, [&](const ubyte_t* match) {
+        if (match < chunk.begin + chunk.size) {
+          found[i] = match;
+          for (auto current = first.load(); i < current && !first.compare_exchange_weak(current, i);) {}
+        }
+        return false;
+      });
+    });
+    return (first < chunks.size()) ? Pointer(const_cast<ubyte_t*>(found[first])) : Pointer(nullptr);
+  }
+
+  /**
+    @brief  Finds every match of pattern
+    @param  pattern Pattern to be found
+    @retval         Match addresses in ascending order
+  **/
+  vector<Pointer> FindAll(const Pattern& pattern) const
+  {
+    auto chunks = Split_(pattern.Size() - 1);
+    vector<vector<Pointer>> found(chunks.size());
+
+    ParallelFor(chunks.size(), [&](const size_t i) {
+      auto& chunk = chunks[i];
+      Scan(chunk.begin, chunk.readable, pattern, [&](const ubyte_t* match) {
+        if (match >= chunk.begin + chunk.size)
+          return false;
+        found[i].emplace_back(const_cast<ubyte_t*>(match));
+        return true;
+      });
+    });
+    return Merge_(found);
+  }
+
+  /**
+    @brief  Finds first match of every pattern in a single pass
+    @param  patterns Patterns to be found
+    @retval          Match address for each pattern, nullptr if not found
+  **/
+  vector<Pointer> FindFirst(const PatternSet& patterns) const
+  {
+    auto chunks = Split_(patterns.MaxSize() - 1);
+    vector<vector<const ubyte_t*>> found(chunks.size());
+
+    ParallelFor(chunks.size(), [&](const size_t i) {
+      auto& chunk = chunks[i];
+      auto remaining = patterns.Size();
+      found[i].resize(patterns.Size(), nullptr);
+      patterns.Scan(chunk.begin, chunk.readable, [&](const size_t index, const ubyte_t* match) {
+        if (match < chunk.begin + chunk.size && !found[i][index]) {
+          found[i][index] = match;
+          --remaining;
+        }
+        return remaining != 0;
+      });
+    });
+
+    vector<Pointer> first(patterns.Size(), nullptr);
+    for (size_t index = 0; index < patterns.Size(); ++index) {
+      for (auto& chunk : found) {
+        if (chunk[index]) {
+          first[index] = const_cast<ubyte_t*>(chunk[index]);
+          break;
+        }
+      }
+    }
+    return first;
+  }
+
+  /**
+    @brief  Finds every match of every pattern in a single pass
+    @param  patterns Patterns to be found
+    @retval          Match addresses in ascending order for each pattern
+  **/
+  vector<vector<Pointer>> FindAll(const PatternSet& patterns) const
+  {
+    auto chunks = Split_(patterns.MaxSize() - 1);
+    vector<vector<vector<Pointer>>> found(chunks.size());
+
+    ParallelFor(chunks.size(), [&](const size_t i) {
+      auto& chunk = chunks[i];
+      found[i].resize(patterns.Size());
+      patterns.Scan(chunk.begin, chunk.readable, [&](const size_t index, const ubyte_t* match) {
+        if (match < chunk.begin + chunk.size)
+          found[i][index].emplace_back(const_cast<ubyte_t*>(match));
+        return true;
+      });
+    });
+
+    vector<vector<Pointer>> all(patterns.Size());
+    for (size_t index = 0; index < patterns.Size(); ++index) {
+      for (auto& chunk : found)
+        all[index].insert(all[index].end(), chunk[index].begin(), chunk[index].end());
+    }
+    return all;
+  }
+
+  /**
+    @brief  Scans memory with the selected instruction set
+    @param  data    Memory to be scanned
+    @param  size    Amount of bytes to be scanned
+    @param  pattern Pattern to be found
+    @param  onMatch Called with each match address in ascending order, returns false to stop
+    @retval         False if stopped by onMatch
+  **/
+  template<class F>
+  static bool Scan(const ubyte_t* data, const size_t size, const Pattern& pattern, F&& onMatch)
+  {
+    switch (isa_) {
+    case Isa::Avx2:
+      return ScanVector_<Avx2_>(data, size, pattern, onMatch);
+    case Isa::Sse2:
+      return ScanVector_<Sse2_>(data, size, pattern, onMatch);
+    default:
+      return ScanScalar_(data, 0, size, pattern, onMatch);
+    }
+  }
+
+  static Isa GetIsa() noexcept
+  {
+    return isa_;
+  }
+
+  /**
+    @brief  Selects instruction set, limited to what CPU supports
+    @param  isa Desired instruction set
+    @retval     Instruction set in use
+  **/
+  static Isa SetIsa(const Isa isa) noexcept
+  {
+    isa_ = _min(isa, GetSupportedIsa());
+    return isa_;
+  }
+
+  static Isa GetSupportedIsa() noexcept
+  {
+    int info[4];
+    __cpuid(info, 0);
+    auto maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    if (!(info[3] & (1 << 26)))
+      return Isa::Scalar;
+
+    // AVX state must be enabled by OS (OSXSAVE + XCR0 XMM/YMM bits)
+    if (maxLeaf >= 7 && (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6) {
+      __cpuidex(info, 7, 0);
+      if (info[1] & (1 << 5))
+        return Isa::Avx2;
+    }
+    return Isa::Sse2;
+  }
+
+private:
+  struct Sse2_ {
+    using reg_t = __m128i;
+    static constexpr size_t kWidth = 16;
+
+    static reg_t Broadcast(const ubyte_t byte) noexcept
+    {
+      return _mm_set1_epi8(static_cast<char>(byte));
+    }
+
+    static uint32_t Equal(const ubyte_t* data, const reg_t& value) noexcept
+    {
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const reg_t*>(data)), value));
+    }
+  };
+
+  struct Avx2_ {
+    using reg_t = __m256i;
+    static constexpr size_t kWidth = 32;
+
+    static reg_t Broadcast(const ubyte_t byte) noexcept
+    {
+      return _mm256_set1_epi8(static_cast<char>(byte));
+    }
+
+    static uint32_t Equal(const ubyte_t* data, const reg_t& value) noexcept
+    {
+      return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const reg_t*>(data)), value));
+    }
+  };
+
+  /**
+    @brief Part of a range scanned by a single task
+  **/
+  struct Chunk_ {
+    const ubyte_t* begin;
+    size_t         size;     //!< Bytes where matches may start
+    size_t         readable; //!< Bytes scanned, overlapping next chunk
+  };
+
+  static constexpr size_t kChunkSize = 0x100000; //!< Bytes where matches of a task may start
+
+  vector<pair<Pointer, size_t>> ranges_; //!< Scanned memory ranges
+
+  static inline Isa isa_ = GetSupportedIsa();
+
+  /**
+    @brief  Splits ranges into chunks
+    @param  overlap Bytes read past each chunk, so matches on chunk boundaries are found
+    @retval         Chunks in ascending order
+  **/
+  vector<Chunk_> Split_(const size_t overlap) const
+  {
+    vector<Chunk_> chunks;
+    for (auto& [begin, size] : ranges_) {
+      for (size_t offset = 0; offset < size; offset += kChunkSize) {
+        auto owned = _min(kChunkSize, size - offset);
+        chunks.push_back({ begin.ToBytes() + offset, owned, _min(owned + overlap, size - offset) });
+      }
+    }
+    return chunks;
+  }
+
+  static vector<Pointer> Merge_(const vector<vector<Pointer>>& found)
+  {
+    vector<Pointer> all;
+    for (auto& chunk : found)
+      all.insert(all.end(), chunk.begin(), chunk.end());
+    return all;
+  }
+
+  template<class V, class F>
+  static bool ScanVector_(const ubyte_t* data, const size_t size, const Pattern& pattern, F& onMatch)
+  {
+    auto [first, second] = pattern.GetAnchors();
+    auto firstValue = V::Broadcast(pattern.GetBytes()[first]);
+    auto secondValue = V::Broadcast(pattern.GetBytes()[second]);
+
+    // each block tests kWidth candidate offsets, all of them must fit a whole pattern
+    size_t pos = 0;
+    for (; pos + V::kWidth + pattern.Size() <= size + 1; pos += V::kWidth) {
+      auto candidates = V::Equal(data + pos + first, firstValue) & V::Equal(data + pos + second, secondValue);
+      for (; candidates; candidates &= candidates - 1) {
+        auto match = data + pos + countr_zero(candidates);
+        if (pattern.Match(match) && !onMatch(match))
+          return false;
+      }
+    }
+    return ScanScalar_(data, pos, size, pattern, onMatch);
+  }
+
+  template<class F>
+  static bool ScanScalar_(const ubyte_t* data, size_t pos, const size_t size, const Pattern& pattern, F& onMatch)
+  {
+    auto first = pattern.GetAnchors().first;
+    auto value = pattern.GetBytes()[first];
+    while (pos + pattern.Size() <= size) {
+      auto anchor = static_cast<const ubyte_t*>(memchr(data + pos + first, value, size - pattern.Size() + 1 - pos));
+      if (!anchor)
+        break;
+
+      auto match = anchor - first;
+      if (pattern.Match(match) && !onMatch(match))
+        return false;
+      pos = match - data + 1;
+    }
+    return true;
+  }
+};
+
+}
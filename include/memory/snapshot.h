@@ -0,0 +1,256 @@
+/**
+  @brief     Snapshot submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "protection.h"
+#include "process.h"
+#include "assembly.h"
+#include "scanner.h"
+
+namespace Memory
+{
+
+/**
+  @class Snapshot
+  @brief Saved copy of memory ranges, compared against live memory to find overwritten bytes
+
+  Ranges are compared 32 bytes at a time with AVX2 (16 with SSE2), so intact ranges only
+  cost a load and compare per block. Captured memory must stay mapped while in use.
+**/
+class Snapshot {
+public:
+  /**
+    @struct Change
+    @brief  Run of bytes that differ from snapshot
+  **/
+  struct Change {
+    Pointer address;
+    size_t  size;
+  };
+
+  Snapshot() = default;
+
+  /**
+    @brief Snapshot object constructor, captures executable sections of a module
+    @param module Module to be captured
+  **/
+  Snapshot(const Module& module)
+  {
+    auto nt = module.GetNtHeaders();
+    auto section = IMAGE_FIRST_SECTION(nt);
+    for (auto i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+      if (section->Characteristics & IMAGE_SCN_MEM_EXECUTE)
+        Add(module.GetBaseAddress() + section->VirtualAddress, section->Misc.VirtualSize);
+    }
+  }
+
+  /**
+    @brief Captures bytes currently in a range
+    @param ptr  Start of range
+    @param size Amount of bytes
+  **/
+  void Add(const Pointer& ptr, const size_t size)
+  {
+    Add_(ptr, ptr.ToAny<const ubyte_t*>(), size);
+  }
+
+  /**
+    @brief Saves bytes expected in a range
+    @param ptr      Start of range
+    @param expected Bytes range should hold
+  **/
+  void Add(const Pointer& ptr, const Data& expected)
+  {
+    Add_(ptr, expected.Bytes(), expected.Size());
+  }
+
+  /**
+    @brief Saves bytes owned by a patch, payload if enabled or original bytes otherwise
+    @param patch Patch to be checked
+  **/
+  void Add(const Patch& patch)
+  {
+    Add(patch.GetAddress(), patch.IsEnabled() ? patch.GetPayload() : patch.GetOriginal());
+  }
+
+  /**
+    @brief  Checks if every range still holds its saved bytes, stopping at first difference
+    @retval bool Is memory unchanged?
+  **/
+  bool IsIntact() const noexcept
+  {
+    for (auto& range : ranges_) {
+      if (Mismatch_(reinterpret_cast<const ubyte_t*>(range.address), bytes_.data() + range.offset, 0, range.size) < range.size)
+        return false;
+    }
+    return true;
+  }
+
+  /**
+    @brief  Finds bytes changed since capture
+    @retval Changed runs, in the order ranges were added
+  **/
+  vector<Change> Diff() const
+  {
+    vector<Change> changes;
+    Diff_([&](const Range_& range, const size_t pos, const size_t size) {
+      changes.push_back({ range.address + pos, size });
+    });
+    return changes;
+  }
+
+  /**
+    @brief  Writes saved bytes over changed runs
+    @retval Amount of runs restored
+  **/
+  size_t Restore()
+  {
+    size_t count = 0;
+    Diff_([&](const Range_& range, const size_t pos, const size_t size) {
+      Pointer ptr = range.address + pos;
+      Protection protection(ptr, size);
+      memcpy(&ptr, bytes_.data() + range.offset + pos, size);
+      ++count;
+    });
+    return count;
+  }
+
+  /**
+    @brief Captures current bytes of every range again, accepting changes made so far
+  **/
+  void Update()
+  {
+    for (auto& range : ranges_)
+      memcpy(bytes_.data() + range.offset, reinterpret_cast<const ubyte_t*>(range.address), range.size);
+  }
+
+  void Clear() noexcept
+  {
+    ranges_.clear();
+    bytes_.clear();
+  }
+
+  /**
+    @brief  Gets amount of ranges
+    @retval size_t Ranges added
+  **/
+  size_t GetCount() const noexcept
+  {
+    return ranges_.size();
+  }
+
+  /**
+    @brief  Gets amount of saved bytes
+    @retval size_t Bytes in every range
+  **/
+  size_t GetSize() const noexcept
+  {
+    return bytes_.size();
+  }
+
+private:
+  /**
+    @brief Captured range, bytes are kept in a single buffer
+  **/
+  struct Range_ {
+    uintptr_t address;
+    size_t    size;
+    size_t    offset; //!< Offset of saved bytes
+  };
+
+  vector<Range_>  ranges_;
+  vector<ubyte_t> bytes_;
+
+  void Add_(const Pointer& ptr, const ubyte_t* bytes, const size_t size)
+  {
+    if (!size)
+      return;
+    ranges_.push_back({ ptr.ToValue(), size, bytes_.size() });
+    bytes_.insert(bytes_.end(), bytes, bytes + size);
+  }
+
+  /**
+    @brief Calls onChange with every run of changed bytes
+    @param onChange Called with range, position of run in range and run size
+  **/
+  template<class F>
+  void Diff_(F&& onChange) const
+  {
+    for (auto& range : ranges_) {
+      auto live = reinterpret_cast<const ubyte_t*>(range.address);
+      auto saved = bytes_.data() + range.offset;
+      for (auto pos = Mismatch_(live, saved, 0, range.size); pos < range.size;) {
+        auto end = pos + 1;
+        while (end < range.size && live[end] != saved[end])
+          ++end;
+        onChange(range, pos, end - pos);
+        pos = Mismatch_(live, saved, end, range.size);
+      }
+    }
+  }
+
+  /**
+    @brief  Finds first differing byte
+    @param  live  Live memory
+    @param  saved Saved bytes
+    @param  pos   First byte compared
+    @param  size  Amount of bytes
+    @retval       Position of first difference, size if none
+  **/
+  static size_t Mismatch_(const ubyte_t* live, const ubyte_t* saved, size_t pos, const size_t size) noexcept
+  {
+    auto isa = Scanner::GetIsa();
+    if (isa == Isa::Avx2) {
+      for (; pos + 32 <= size; pos += 32) {
+        auto equal = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(live + pos)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(saved + pos)))));
+        if (equal != 0xFFFFFFFFu)
+          return pos + countr_zero(~equal);
+      }
+    }
+    if (isa != Isa::Scalar) {
+      for (; pos + 16 <= size; pos += 16) {
+        auto equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(live + pos)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(saved + pos)))));
+        if (equal != 0xFFFFu)
+          return pos + countr_zero(~equal);
+      }
+    }
+    // patches are often shorter than a vector
+    for (; pos + 8 <= size; pos += 8) {
+      uint64_t a, b;
+      memcpy(&a, live + pos, 8);
+      memcpy(&b, saved + pos, 8);
+      if (a != b)
+        return pos + countr_zero(a ^ b) / 8;
+    }
+    while (pos < size && live[pos] == saved[pos])
+      ++pos;
+    return pos;
+  }
+};
+
+}
@@ -0,0 +1,457 @@
+/**
+  @brief     ValueScanner submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "data.h"
+#include "parallel.h"
+#include "scanner.h"
+#include "memorymap.h"
+
+namespace Memory
+{
+
+/**
+  @brief Comparison applied to every candidate of a value scan
+**/
+enum class Compare {
+  Exact,     //!< Equal to value
+  Range,     //!< Between value and upper, both included
+  Changed,   //!< Different from previous scan
+  Unchanged, //!< Same as previous scan
+  Increased, //!< Greater than previous scan
+  Decreased  //!< Less than previous scan
+};
+
+/**
+  @class ValueScanner
+  @brief Finds typed values in writable memory and narrows them down across scans
+
+  First scan reads every writable region in blocks of kBlockSize bytes, comparing
+  naturally aligned values with AVX2 when available. Candidates are kept per block
+  as 16-bit offsets next to the value last seen, so later scans only re-read the
+  span of each block still holding candidates.
+
+  Scan buffers and values last seen live in pages the scanner allocates apart from
+  the heap, which its walks skip, so copies it keeps are never found as candidates.
+**/
+template<class T>
+class ValueScanner {
+  static_assert(is_same_v<T, int32_t> || is_same_v<T, int64_t> || is_same_v<T, float> || is_same_v<T, double>,
+                "ValueScanner supports int32_t, int64_t, float and double");
+
+public:
+  static constexpr size_t kBlockSize = 0x10000;
+  static constexpr size_t kTaskSize = 0x100000; //!< Bytes scanned by a single task of first scan
+
+  ValueScanner() : values_(make_unique<Pages_>()), buffers_(make_unique<Pages_>()), count_(0) {}
+
+  /**
+    @brief  Scans writable regions of the current process
+    @param  compare Exact or Range
+    @param  value   Value, or lower bound of range
+    @param  upper   Upper bound of range
+    @retval         Amount of candidates found
+  **/
+  size_t First(const Compare compare, const T value, const T upper = T())
+  {
+    return First(MemoryMap(), compare, value, upper);
+  }
+
+  /**
+    @brief  Scans writable regions of a memory map
+    @param  map     Regions to be scanned
+    @param  compare Exact or Range
+    @param  value   Value, or lower bound of range
+    @param  upper   Upper bound of range
+    @retval         Amount of candidates found
+  **/
+  size_t First(const MemoryMap& map, const Compare compare, const T value, const T upper = T())
+  {
+    if (compare != Compare::Exact && compare != Compare::Range)
+      _throws("First scan has no previous values to compare with");
+
+    // tasks cover several blocks, only those holding candidates are kept
+    auto values = make_unique<Pages_>();
+    vector<pair<uintptr_t, size_t>> tasks;
+    for (auto& region : map.GetRegions()) {
+      if (!region.IsWritable() || IsOwned_(region.base, region.size))
+        continue;
+      for (size_t offset = 0; offset < region.size; offset += kTaskSize)
+        tasks.emplace_back(region.base + offset, min<size_t>(kTaskSize, region.size - offset));
+    }
+
+    // pages allocated after map was taken may reuse addresses of its regions
+    vector<vector<Block_>> found(tasks.size());
+    ParallelFor(tasks.size(), [&](const size_t i) {
+      auto [base, size] = tasks[i];
+      for (size_t offset = 0; offset < size; offset += kBlockSize) {
+        Block_ block{ base + offset, min<size_t>(kBlockSize, size - offset) };
+        if (IsOwned_(block.base, block.size) || values->Overlaps(block.base, block.size))
+          continue;
+        ScanBlock_(block, *values, compare, value, upper);
+        if (!block.offsets.empty())
+          found[i].push_back(move(block));
+      }
+    });
+
+    blocks_.clear();
+    values_ = move(values);
+    for (auto& blocks : found)
+      move(blocks.begin(), blocks.end(), back_inserter(blocks_));
+    return Compact_();
+  }
+
+  /**
+    @brief  Re-reads candidates, keeping only those matching comparison
+    @param  compare Any comparison
+    @param  value   Value, or lower bound of range
+    @param  upper   Upper bound of range
+    @retval         Amount of candidates left
+  **/
+  size_t Next(const Compare compare, const T value = T(), const T upper = T())
+  {
+    if (blocks_.empty())
+      return count_ = 0;
+
+    ParallelFor(blocks_.size(), [&](const size_t i) {
+      if (IsOwned_(blocks_[i].base, blocks_[i].size))
+        blocks_[i].offsets.clear();
+      else
+        NarrowBlock_(blocks_[i], compare, value, upper);
+    });
+    return Compact_();
+  }
+
+  /**
+    @brief  Gets candidates in ascending address order
+    @param  limit Maximum amount of candidates returned
+    @retval       Candidate addresses with the value seen on last scan
+  **/
+  vector<pair<Pointer, T>> GetResults(const size_t limit = numeric_limits<size_t>::max()) const
+  {
+    vector<pair<Pointer, T>> results;
+    results.reserve(min<size_t>(limit, count_));
+    for (auto& block : blocks_) {
+      for (size_t i = 0; i < block.offsets.size(); ++i) {
+        if (results.size() == limit)
+          return results;
+        results.emplace_back(block.base + block.offsets[i], block.values[i]);
+      }
+    }
+    return results;
+  }
+
+  constexpr size_t GetCount() const noexcept
+  {
+    return count_;
+  }
+
+  void Reset()
+  {
+    blocks_.clear();
+    values_ = make_unique<Pages_>();
+    count_ = 0;
+  }
+
+private:
+  static constexpr size_t kPageSize = 0x1000;
+  static constexpr size_t kChunkSize = 0x100000; //!< Least bytes allocated at once for values
+
+  /**
+    @class Pages_
+    @brief Pages allocated by the scanner apart from the heap
+
+    Hands out values last seen from chunks of at least kChunkSize bytes, never
+    freeing them one by one, and scan buffers of kBlockSize bytes reused by
+    later tasks. Every page is released when this object gets destroyed.
+  **/
+  class Pages_ {
+  public:
+    Pages_() : next_(nullptr), left_(0), used_(0) {}
+
+    Pages_(const Pages_&) = delete;
+    Pages_& operator=(const Pages_&) = delete;
+
+    ~Pages_()
+    {
+      for (auto& region : regions_)
+        VirtualFree(region.first, 0, MEM_RELEASE);
+    }
+
+    /**
+      @brief  Allocates room for values
+      @param  count Amount of values
+      @retval       Values, kept until this object gets destroyed
+    **/
+    T* Allocate(const size_t count)
+    {
+      auto size = (count * sizeof(T) + 31) & ~static_cast<size_t>(31);
+      lock_guard<mutex> lock(mutex_);
+      if (size > left_) {
+        left_ = max(size, kChunkSize);
+        next_ = Commit_(left_);
+      }
+      auto values = reinterpret_cast<T*>(next_);
+      next_ += size;
+      left_ -= size;
+      used_ += size;
+      return values;
+    }
+
+    /**
+      @brief  Takes a scan buffer, allocating one if every buffer is taken
+      @retval Buffer of kBlockSize bytes, aligned to a page
+    **/
+    ubyte_t* Acquire()
+    {
+      lock_guard<mutex> lock(mutex_);
+      if (buffers_.empty())
+        return Commit_(kBlockSize);
+      auto buffer = buffers_.back();
+      buffers_.pop_back();
+      return buffer;
+    }
+
+    void Release(ubyte_t* buffer)
+    {
+      lock_guard<mutex> lock(mutex_);
+      buffers_.push_back(buffer);
+    }
+
+    /**
+      @brief  Check if a range overlaps any page of this object
+      @param  base Range start
+      @param  size Amount of bytes
+      @retval bool Does range overlap?
+    **/
+    bool Overlaps(const uintptr_t base, const size_t size)
+    {
+      lock_guard<mutex> lock(mutex_);
+      return any_of(regions_.begin(), regions_.end(), [&](const pair<ubyte_t*, size_t>& region) {
+        auto start = reinterpret_cast<uintptr_t>(region.first);
+        return start < base + size && base < start + region.second;
+      });
+    }
+
+    /**
+      @brief  Gets amount of bytes handed out for values
+      @retval size_t Bytes, freed values included
+    **/
+    size_t GetUsed()
+    {
+      lock_guard<mutex> lock(mutex_);
+      return used_;
+    }
+
+  private:
+    mutex                          mutex_;
+    vector<pair<ubyte_t*, size_t>> regions_; //!< Every allocation with its size
+    vector<ubyte_t*>               buffers_; //!< Scan buffers not taken
+    ubyte_t*                       next_;    //!< Next free byte of last chunk
+    size_t                         left_;    //!< Free bytes of last chunk
+    size_t                         used_;
+
+    ubyte_t* Commit_(const size_t size)
+    {
+      auto memory = static_cast<ubyte_t*>(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+      if (!memory)
+        _throws("Could not allocate scanner pages");
+      regions_.emplace_back(memory, size);
+      return memory;
+    }
+  };
+
+  /**
+    @brief Candidates within kBlockSize bytes of a region
+  **/
+  struct Block_ {
+    uintptr_t        base;
+    size_t           size;
+    vector<ushort_t> offsets; //!< Candidate offsets from base, ascending
+    T*               values;  //!< Value seen on last scan, in values_ pages
+  };
+
+  vector<Block_>     blocks_;
+  unique_ptr<Pages_> values_;  //!< Values of every block
+  unique_ptr<Pages_> buffers_; //!< Scan buffers
+  size_t             count_;   //!< Candidates in all blocks
+
+  bool IsOwned_(const uintptr_t base, const size_t size)
+  {
+    return values_->Overlaps(base, size) || buffers_->Overlaps(base, size);
+  }
+
+  static bool Test_(const T current, const T previous, const Compare compare, const T value, const T upper) noexcept
+  {
+    switch (compare) {
+    case Compare::Exact:
+      return current == value;
+    case Compare::Range:
+      return current >= value && current <= upper;
+    case Compare::Changed:
+      return memcmp(&current, &previous, sizeof(T)) != 0;
+    case Compare::Unchanged:
+      return memcmp(&current, &previous, sizeof(T)) == 0;
+    case Compare::Increased:
+      return current > previous;
+    default:
+      return current < previous;
+    }
+  }
+
+  /**
+    @brief  Compares 32 bytes of aligned values at once
+    @param  data    Aligned values
+    @param  compare Exact or Range
+    @retval         Bit mask of matching values
+  **/
+  static uint32_t Match_(const ubyte_t* data, const Compare compare, const T value, const T upper) noexcept
+  {
+    if constexpr (is_same_v<T, float>) {
+      auto current = _mm256_load_ps(reinterpret_cast<const float*>(data));
+      if (compare == Compare::Exact)
+        return _mm256_movemask_ps(_mm256_cmp_ps(current, _mm256_set1_ps(value), _CMP_EQ_OQ));
+      return _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(current, _mm256_set1_ps(value), _CMP_GE_OQ),
+                                              _mm256_cmp_ps(current, _mm256_set1_ps(upper), _CMP_LE_OQ)));
+    }
+    else if constexpr (is_same_v<T, double>) {
+      auto current = _mm256_load_pd(reinterpret_cast<const double*>(data));
+      if (compare == Compare::Exact)
+        return _mm256_movemask_pd(_mm256_cmp_pd(current, _mm256_set1_pd(value), _CMP_EQ_OQ));
+      return _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(current, _mm256_set1_pd(value), _CMP_GE_OQ),
+                                              _mm256_cmp_pd(current, _mm256_set1_pd(upper), _CMP_LE_OQ)));
+    }
+    else if constexpr (is_same_v<T, int32_t>) {
+      auto current = _mm256_load_si256(reinterpret_cast<const __m256i*>(data));
+      if (compare == Compare::Exact)
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(current, _mm256_set1_epi32(value))));
+      auto outside = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(value), current),
+                                     _mm256_cmpgt_epi32(current, _mm256_set1_epi32(upper)));
+      return ~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xFF;
+    }
+    else {
+      auto current = _mm256_load_si256(reinterpret_cast<const __m256i*>(data));
+      if (compare == Compare::Exact)
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(current, _mm256_set1_epi64x(value))));
+      auto outside = _mm256_or_si256(_mm256_cmpgt_epi64(_mm256_set1_epi64x(value), current),
+                                     _mm256_cmpgt_epi64(current, _mm256_set1_epi64x(upper)));
+      return ~_mm256_movemask_pd(_mm256_castsi256_pd(outside)) & 0xF;
+    }
+  }
+
+  void ScanBlock_(Block_& block, Pages_& values, const Compare compare, const T value, const T upper)
+  {
+    // regions may be freed by other threads while scanned, so work on a copy
+    auto buffer = buffers_->Acquire();
+    if (!SafeRead(block.base, buffer, block.size)) {
+      buffers_->Release(buffer);
+      return;
+    }
+
+    auto count = block.size / sizeof(T);
+    size_t i = 0;
+    if (Scanner::GetIsa() == Isa::Avx2) {
+      constexpr size_t kLanes = 32 / sizeof(T);
+      for (; i + kLanes <= count; i += kLanes) {
+        for (auto mask = Match_(buffer + i * sizeof(T), compare, value, upper); mask; mask &= mask - 1)
+          block.offsets.push_back(static_cast<ushort_t>((i + countr_zero(mask)) * sizeof(T)));
+      }
+    }
+    for (; i < count; ++i) {
+      T current;
+      memcpy(&current, buffer + i * sizeof(T), sizeof(T));
+      if (Test_(current, current, compare, value, upper))
+        block.offsets.push_back(static_cast<ushort_t>(i * sizeof(T)));
+    }
+
+    if (!block.offsets.empty()) {
+      block.values = values.Allocate(block.offsets.size());
+      for (size_t j = 0; j < block.offsets.size(); ++j)
+        memcpy(&block.values[j], buffer + block.offsets[j], sizeof(T));
+    }
+    buffers_->Release(buffer);
+  }
+
+  void NarrowBlock_(Block_& block, const Compare compare, const T value, const T upper)
+  {
+    if (block.offsets.empty())
+      return;
+
+    // only bytes between first and last candidate are read again
+    auto buffer = buffers_->Acquire();
+    size_t first = block.offsets.front();
+    size_t last = block.offsets.back() + sizeof(T);
+    static_assert(kBlockSize / kPageSize <= 32);
+    uint32_t readable = ~0u; //!< Bit per page of block
+
+    // a freed page only drops its own candidates, values never cross pages as blocks are page aligned
+    if (!SafeRead(block.base + first, buffer, last - first)) {
+      readable = 0;
+      for (auto page = first & ~(kPageSize - 1); page < last; page += kPageSize) {
+        auto begin = max(page, first);
+        auto end = min(page + kPageSize, last);
+        if (SafeRead(block.base + begin, buffer + (begin - first), end - begin))
+          readable |= 1u << (page / kPageSize);
+      }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < block.offsets.size(); ++i) {
+      if (!(readable & (1u << (block.offsets[i] / kPageSize))))
+        continue;
+      T current;
+      memcpy(&current, buffer + (block.offsets[i] - first), sizeof(T));
+      if (!Test_(current, block.values[i], compare, value, upper))
+        continue;
+      block.offsets[kept] = block.offsets[i];
+      block.values[kept++] = current;
+    }
+    block.offsets.resize(kept);
+    buffers_->Release(buffer);
+  }
+
+  size_t Compact_()
+  {
+    erase_if(blocks_, [](const Block_& block) { return block.offsets.empty(); });
+    count_ = 0;
+    for (auto& block : blocks_) {
+      block.offsets.shrink_to_fit();
+      count_ += block.offsets.size();
+    }
+
+    // values of dropped candidates are only freed by moving live ones to new pages
+    if (values_->GetUsed() > 2 * count_ * sizeof(T) + kChunkSize) {
+      auto values = make_unique<Pages_>();
+      for (auto& block : blocks_) {
+        auto moved = values->Allocate(block.offsets.size());
+        memcpy(moved, block.values, block.offsets.size() * sizeof(T));
+        block.values = moved;
+      }
+      values_ = move(values);
+    }
+    return count_;
+  }
+};
+
+}
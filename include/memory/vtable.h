@@ -0,0 +1,216 @@
+/**
+  @brief     VTable submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "memorymap.h"
+#include "protection.h"
+
+namespace Memory
+{
+
+/**
+  @brief  Gets virtual table an object currently points to
+  @param  object Polymorphic object
+  @retval        Virtual table
+**/
+inline pvoid_t* GetVTable(const Pointer& object) noexcept
+{
+  return *object.ToObject<pvoid_t*>();
+}
+
+/**
+  @class VTableHook
+  @brief Object used to swap a virtual table slot, affecting every object sharing the table
+**/
+class VTableHook {
+public:
+  /**
+    @brief VTableHook object constructor
+    @param object      Any object using the virtual table
+    @param index       Virtual method index
+    @param replacement Function called instead, taking the object as first argument
+    @param enable      Should slot be swapped right away?
+  **/
+  VTableHook(const Pointer& object, const size_t index, const Pointer& replacement, const bool enable = true) :
+    slot_(GetVTable(object) + index), original_(*slot_), replacement_(replacement), isEnabled_(false)
+  {
+    if (!replacement_.ToVoid())
+      _throws("Invalid arguments");
+    if (enable)
+      Enable();
+  }
+
+  /**
+    @brief VTableHook object destructor, restores slot
+  **/
+  ~VTableHook()
+  {
+    Disable();
+  }
+
+  VTableHook(const VTableHook&) = delete;
+  VTableHook& operator=(const VTableHook&) = delete;
+
+  /**
+    @brief Swaps slot for replacement
+  **/
+  void Enable()
+  {
+    if (!isEnabled_)
+      isEnabled_ = Swap_(original_, replacement_);
+  }
+
+  /**
+    @brief Restores slot, unless someone else changed it since
+  **/
+  void Disable()
+  {
+    if (isEnabled_)
+      isEnabled_ = !Swap_(replacement_, original_);
+  }
+
+  /**
+    @brief  Check if slot is swapped
+    @retval bool Is hook enabled?
+  **/
+  constexpr bool IsEnabled() const noexcept
+  {
+    return isEnabled_;
+  }
+
+  /**
+    @brief  Gets original method, safe to call while hook is enabled
+    @retval Pointer Original method
+  **/
+  constexpr const Pointer& GetOriginal() const noexcept
+  {
+    return original_;
+  }
+
+private:
+  pvoid_t* slot_;
+  Pointer  original_;
+  Pointer  replacement_;
+  bool     isEnabled_;    //!< Is slot swapped?
+
+  bool Swap_(const Pointer& from, const Pointer& to)
+  {
+    Protection protection(slot_, sizeof(pvoid_t), Protection::GetWritableMode(slot_, sizeof(pvoid_t)));
+    return InterlockedCompareExchangePointer(slot_, to.ToVoid(), from.ToVoid()) == from.ToVoid();
+  }
+};
+
+/**
+  @class ShadowVTable
+  @brief Object used to point a single object to a copy of its virtual table
+
+  Methods hooked in the copy only affect that object, other objects of the
+  same class keep using the original table.
+  @warning This object must be destroyed before the shadowed object, or
+           released by calling Detach
+**/
+class ShadowVTable {
+public:
+  /**
+    @brief ShadowVTable object constructor
+    @param object Polymorphic object
+    @param size   Amount of virtual methods copied, must cover every hooked index
+  **/
+  ShadowVTable(const Pointer& object, const size_t size) :
+    object_(object.ToObject<pvoid_t>()), original_(GetVTable(object)), table_(size + 1)
+  {
+    if (!size)
+      _throws("Invalid arguments");
+
+    // slot before table holds run-time type information
+    memcpy(table_.data(), original_ - 1, table_.size() * sizeof(pvoid_t));
+    if (InterlockedCompareExchangePointer(object_, table_.data() + 1, original_) != original_)
+      _throws("Object virtual table changed while being shadowed");
+  }
+
+  /**
+    @brief ShadowVTable object destructor, points object back to its original table
+  **/
+  ~ShadowVTable()
+  {
+    Detach();
+  }
+
+  ShadowVTable(const ShadowVTable&) = delete;
+  ShadowVTable& operator=(const ShadowVTable&) = delete;
+
+  /**
+    @brief  Replaces virtual method of this object only
+    @param  index       Virtual method index
+    @param  replacement Function called instead, taking the object as first argument
+    @retval Pointer     Original method
+  **/
+  Pointer Hook(const size_t index, const Pointer& replacement)
+  {
+    if (index + 1 >= table_.size() || !replacement.ToVoid())
+      _throws("Invalid arguments");
+    InterlockedExchangePointer(&table_[index + 1], replacement.ToVoid());
+    return original_[index];
+  }
+
+  /**
+    @brief Restores virtual method of this object
+    @param index Virtual method index
+  **/
+  void Unhook(const size_t index)
+  {
+    if (index + 1 >= table_.size())
+      _throws("Invalid arguments");
+    InterlockedExchangePointer(&table_[index + 1], original_[index]);
+  }
+
+  /**
+    @brief Points object back to its original table, unless someone else changed it since
+  **/
+  void Detach() noexcept
+  {
+    if (object_)
+      InterlockedCompareExchangePointer(object_, original_, table_.data() + 1);
+    object_ = nullptr;
+  }
+
+  /**
+    @brief  Gets original method, safe to call while hooked
+    @param  index   Virtual method index
+    @retval Pointer Original method
+  **/
+  Pointer GetOriginal(const size_t index) const
+  {
+    if (index + 1 >= table_.size())
+      _throws("Invalid arguments");
+    return original_[index];
+  }
+
+private:
+  pvoid_t*        object_;   //!< Object virtual table pointer, nullptr once detached
+  pvoid_t*        original_; //!< Original virtual table
+  vector<pvoid_t> table_;    //!< Copied virtual table, preceded by its type information slot
+};
+
+}
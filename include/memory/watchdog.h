@@ -0,0 +1,272 @@
+/**
+  @brief     Watchdog submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+#include "protection.h"
+#include "assembly.h"
+
+namespace Memory
+{
+
+/**
+  @class Watchdog
+  @brief Checks patch sites in background, reporting or re-applying overwritten patches
+
+  Each check hashes the live bytes of a site and compares them with hashes of the
+  payload and original bytes. Both are valid states, so patches toggled meanwhile
+  are never mistaken for overwritten ones, and checks take no lock shared with
+  Patch::Enable or Patch::Disable. A site is only acted upon after failing two
+  checks in a row, which skips patches caught while being written. Repairs hold
+  the patch lock and hash the site again before writing it.
+
+  @note Patches must be removed before being destroyed.
+**/
+class Watchdog {
+public:
+  /**
+    @brief Called with every overwritten patch, must not add or remove sites
+  **/
+  using callback_t = function<void(const Patch& patch, const bool isRestored)>;
+
+  static constexpr size_t kBatchSize = 64; //!< Sites checked between budget checks
+
+  /**
+    @brief Watchdog object constructor, checks only run once started
+    @param onOverwrite Called with every overwritten patch
+    @param isRestoring Should overwritten patches be written again?
+  **/
+  Watchdog(callback_t onOverwrite = nullptr, const bool isRestoring = true) :
+    onOverwrite_(onOverwrite), isRestoring_(isRestoring), stop_(nullptr), checks_(0), overwrites_(0)
+  {
+  }
+
+  Watchdog(const Watchdog&) = delete;
+
+  /**
+    @brief Watchdog object destructor
+  **/
+  ~Watchdog()
+  {
+    Stop();
+  }
+
+  /**
+    @brief Starts checking sites in background
+    @param interval Time between the start of two passes over every site
+    @param budget   Fraction of a core spent checking, in (0, 1]
+  **/
+  void Start(const chrono::milliseconds interval = chrono::milliseconds(100), const double budget = 0.01)
+  {
+    if (budget <= 0.0 || budget > 1.0)
+      _throws("Invalid CPU budget");
+    Stop();
+    stop_ = CreateEventW(nullptr, true, false, nullptr);
+    if (stop_ == nullptr)
+      _throws("Could not create watchdog event");
+    thread_ = thread(&Watchdog::Watch_, this, interval, budget);
+  }
+
+  /**
+    @brief Stops background checks, waiting for the current batch
+  **/
+  void Stop()
+  {
+    if (stop_ == nullptr)
+      return;
+    SetEvent(stop_);
+    if (thread_.joinable())
+      thread_.join();
+    CloseHandle(stop_);
+    stop_ = nullptr;
+  }
+
+  /**
+    @brief Starts watching a patch site
+    @param patch Patch to be watched, must outlive watchdog or be removed
+  **/
+  void Add(const Patch& patch)
+  {
+    Site_ site{ &patch, Hash_(patch.GetPayload()), Hash_(patch.GetOriginal()), false };
+    lock_guard<mutex> lock(mutex_);
+    sites_.push_back(site);
+  }
+
+  /**
+    @brief  Stops watching a patch site
+    @param  patch Patch to be removed
+    @retval       False if patch was not watched
+  **/
+  bool Remove(const Patch& patch)
+  {
+    lock_guard<mutex> lock(mutex_);
+    return erase_if(sites_, [&](const Site_& site) { return site.patch == &patch; }) != 0;
+  }
+
+  /**
+    @brief  Checks every site once on calling thread
+    @retval Amount of patches found overwritten
+  **/
+  size_t Check()
+  {
+    size_t found = 0;
+    for (size_t next = 0;;) {
+      lock_guard<mutex> lock(mutex_);
+      if (next >= sites_.size())
+        return found;
+      found += CheckBatch_(next);
+    }
+  }
+
+  /**
+    @brief  Gets amount of site checks
+    @retval size_t Checks made so far
+  **/
+  size_t GetChecks() const noexcept
+  {
+    return checks_.load();
+  }
+
+  /**
+    @brief  Gets amount of overwritten patches found
+    @retval size_t Overwrites found so far
+  **/
+  size_t GetOverwrites() const noexcept
+  {
+    return overwrites_.load();
+  }
+
+private:
+  /**
+    @brief Watched patch with hashes of its valid states
+  **/
+  struct Site_ {
+    const Patch* patch;
+    uint64_t     payload;     //!< Hash of bytes when enabled
+    uint64_t     original;    //!< Hash of bytes when disabled
+    bool         isSuspected; //!< Failed last check
+  };
+
+  callback_t     onOverwrite_;
+  bool           isRestoring_; //!< Are overwritten patches written again?
+  vector<Site_>  sites_;
+  mutex          mutex_;       //!< Guards sites, never taken by patches
+  handle_t       stop_;        //!< Event signaled to stop thread
+  thread         thread_;
+  atomic<size_t> checks_;
+  atomic<size_t> overwrites_;
+
+  static uint64_t Hash_(const ubyte_t* bytes, const size_t size) noexcept
+  {
+    return string_hash(string_view(reinterpret_cast<const char*>(bytes), size));
+  }
+
+  static uint64_t Hash_(const Data& data) noexcept
+  {
+    return Hash_(data.Bytes(), data.Size());
+  }
+
+  /**
+    @brief  Checks up to kBatchSize sites, caller holds mutex
+    @param  next Index of first site, advanced past checked sites
+    @retval      Amount of patches found overwritten
+  **/
+  size_t CheckBatch_(size_t& next)
+  {
+    size_t found = 0;
+    auto first = next;
+    auto end = min<size_t>(next + kBatchSize, sites_.size());
+    for (; next < end; ++next) {
+      auto& site = sites_[next];
+      auto& payload = site.patch->GetPayload();
+      auto hash = Hash_(site.patch->GetAddress().ToAny<const ubyte_t*>(), payload.Size());
+      if (hash == site.payload || hash == site.original) {
+        site.isSuspected = false;
+        continue;
+      }
+      if (!site.isSuspected) {
+        site.isSuspected = true;
+        continue;
+      }
+
+      site.isSuspected = false;
+      ++found;
+      auto isRestored = isRestoring_ && Restore_(site);
+      if (onOverwrite_)
+        onOverwrite_(*site.patch, isRestored);
+    }
+    checks_ += end - first;
+    overwrites_ += found;
+    return found;
+  }
+
+  /**
+    @brief  Writes bytes of current patch state again, unless site got intact meanwhile
+    @param  site Overwritten site
+    @retval bool Were bytes written?
+  **/
+  static bool Restore_(const Site_& site)
+  {
+    // state and bytes can not change while locked, so only bytes of current state are valid
+    auto lock = site.patch->Lock();
+    auto isEnabled = site.patch->IsEnabled();
+    auto& bytes = isEnabled ? site.patch->GetPayload() : site.patch->GetOriginal();
+    Pointer ptr = site.patch->GetAddress();
+    if (Hash_(ptr.ToAny<const ubyte_t*>(), bytes.Size()) == (isEnabled ? site.payload : site.original))
+      return false;
+    Protection protection(ptr, bytes.Size());
+    memcpy(&ptr, bytes.Bytes(), bytes.Size());
+    return true;
+  }
+
+  void Watch_(const chrono::milliseconds interval, const double budget)
+  {
+    using clock = chrono::steady_clock;
+    auto pass = clock::now();
+    chrono::duration<double, milli> debt(0);
+    size_t next = 0;
+    for (;;) {
+      auto start = clock::now();
+      bool isPassDone;
+      {
+        lock_guard<mutex> lock(mutex_);
+        CheckBatch_(next);
+        isPassDone = next >= sites_.size();
+      }
+
+      // time spent checking is paid back by idling, so checks take at most budget of a core
+      debt += (clock::now() - start) * ((1.0 - budget) / budget);
+      auto wait = chrono::duration_cast<chrono::milliseconds>(debt);
+      debt -= wait;
+      if (isPassDone) {
+        next = 0;
+        pass = max(pass + interval, clock::now());
+        wait = max(wait, chrono::duration_cast<chrono::milliseconds>(pass - clock::now()));
+      }
+      if (WaitForSingleObject(stop_, static_cast<ulong_t>(wait.count())) == WAIT_OBJECT_0)
+        return;
+    }
+  }
+};
+
+}
@@ -0,0 +1,440 @@
+/**
+  @brief     WriteWatch submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "pointer.h"
+
+namespace Memory
+{
+
+/**
+  @class WriteWatch
+  @brief Reports pages written since last poll
+
+  Memory allocated with MEM_WRITE_WATCH (see Allocate) is tracked by the system at
+  no cost for the writer. Any other writable memory falls back to protection faults:
+  pages are made read-only and the first write to each page is caught by a vectored
+  exception handler, which restores protection and marks the page. Either way a
+  page costs at most one fault between two polls, no matter how often it is written.
+
+  Page states, tables and poll buffers live in pages of their own, which are never
+  watched, so neither the handler nor a poll writes into a page it made read-only.
+
+  @note Faults are only raised by user-mode writes. System calls writing into a
+        watched page (e.g. ReadFile) fail with ERROR_NOACCESS instead.
+**/
+class WriteWatch {
+public:
+  static constexpr size_t kPageSize = 0x1000;
+
+  /**
+    @brief WriteWatch object constructor, installs exception handler with the first watch
+  **/
+  WriteWatch()
+  {
+    lock_guard<mutex> lock(mutex_);
+    if (!handler_)
+      handler_ = AddVectoredExceptionHandler(1, OnFault_);
+    watches_.push_back(this);
+  }
+
+  WriteWatch(const WriteWatch&) = delete;
+  WriteWatch& operator=(const WriteWatch&) = delete;
+
+  /**
+    @brief WriteWatch object destructor, restores protection of every watched page
+  **/
+  ~WriteWatch()
+  {
+    while (!ranges_.empty())
+      Remove(ranges_.back().base);
+    lock_guard<mutex> lock(mutex_);
+    erase(watches_, this);
+    if (watches_.empty() && handler_) {
+      RemoveVectoredExceptionHandler(handler_);
+      handler_ = nullptr;
+    }
+  }
+
+  /**
+    @brief  Allocates memory tracked by the system, watched without faults
+    @param  size    Amount of bytes
+    @param  protect Page protection
+    @retval         Allocated memory, released with VirtualFree
+  **/
+  static Pointer Allocate(const size_t size, const ulong_t protect = PAGE_READWRITE)
+  {
+    auto memory = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE | MEM_WRITE_WATCH, protect);
+    if (!memory)
+      _throws("Could not allocate write watched memory");
+    return memory;
+  }
+
+  /**
+    @brief  Starts watching pages of a range
+    @param  ptr  Start of range
+    @param  size Amount of bytes
+    @retval      False if range is not writable, overlaps watched pages or pages used by watches
+  **/
+  bool Add(const Pointer& ptr, const size_t size)
+  {
+    if (!size)
+      return false;
+    auto base = ptr.ToAny<uintptr_t>() & ~(kPageSize - 1);
+    auto end = (ptr.ToAny<uintptr_t>() + size + kPageSize - 1) & ~(kPageSize - 1);
+
+    lock_guard<mutex> lock(mutex_);
+    if (IsOwned_(base, end - base))
+      return false;
+    for (auto watch : watches_) {
+      for (auto& range : watch->ranges_) {
+        if (base < range.base + range.size && range.base < end)
+          return false;
+      }
+    }
+
+    pvoid_t address;
+    ULONG_PTR count = 1;
+    ulong_t granularity;
+    if (!GetWriteWatch(0, reinterpret_cast<pvoid_t>(base), end - base, &address, &count, &granularity)) {
+      ResetWriteWatch(reinterpret_cast<pvoid_t>(base), end - base);
+      ranges_.push_back({ base, end - base });
+      return true;
+    }
+
+    Range_ range = { base, end - base, Pages_((end - base) / kPageSize) };
+    for (size_t i = 0; i < range.size / kPageSize; ++i) {
+      MEMORY_BASIC_INFORMATION info;
+      auto page = base + i * kPageSize;
+      if (!VirtualQuery(reinterpret_cast<pvoid_t>(page), &info, sizeof(info)) || info.State != MEM_COMMIT ||
+          !ReadOnly_(info.Protect))
+        return false;
+      range.pages[i].address = page;
+      range.pages[i].protect = info.Protect;
+    }
+
+    // pages are published before being protected, so their first fault always finds them
+    auto table = make_unique<Table_>(*table_.load());
+    for (size_t i = 0; i < range.size / kPageSize; ++i)
+      table->push_back(&range.pages[i]);
+    sort(table->begin(), table->end(), [](const Page_* a, const Page_* b) { return a->address < b->address; });
+    Publish_(table.release());
+
+    for (size_t i = 0; i < range.size / kPageSize; ++i)
+      Protect_(range.pages[i], true);
+    ranges_.push_back(move(range));
+    return true;
+  }
+
+  /**
+    @brief  Stops watching a range
+    @param  ptr Start of range given to Add
+    @retval     False if no range starts at ptr
+  **/
+  bool Remove(const Pointer& ptr)
+  {
+    auto base = ptr.ToAny<uintptr_t>() & ~(kPageSize - 1);
+    lock_guard<mutex> lock(mutex_);
+    auto range = find_if(ranges_.begin(), ranges_.end(), [&](const Range_& range) { return range.base == base; });
+    if (range == ranges_.end())
+      return false;
+
+    // pages stay published until their protection is back, a fault raised meanwhile still finds them
+    if (!range->pages.empty()) {
+      auto end = range->base + range->size;
+      for (size_t i = 0; i < range->size / kPageSize; ++i) {
+        auto& page = range->pages[i];
+        Acquire_(page);
+        Protect_(page, false);
+        page.isBusy.clear(memory_order_release);
+      }
+
+      auto table = make_unique<Table_>();
+      for (auto page : *table_.load()) {
+        if (page->address < base || page->address >= end)
+          table->push_back(page);
+      }
+      Publish_(table.release());
+    }
+    ranges_.erase(range);
+    return true;
+  }
+
+  /**
+    @brief  Gets pages written since last poll and watches them again
+    @retval Addresses of written pages in ascending order
+  **/
+  vector<Pointer> Poll()
+  {
+    lock_guard<mutex> lock(mutex_);
+    written_.clear();
+    dirty_.clear();
+    for (auto& range : ranges_) {
+      if (!range.pages.empty()) {
+        for (auto& page : range.pages) {
+          if (page.isDirty)
+            dirty_.push_back(&page);
+        }
+        continue;
+      }
+      addresses_.resize(max(addresses_.size(), range.size / kPageSize));
+      ULONG_PTR count = range.size / kPageSize;
+      ulong_t granularity;
+      if (!GetWriteWatch(WRITE_WATCH_FLAG_RESET, reinterpret_cast<pvoid_t>(range.base), range.size, addresses_.data(),
+                         &count, &granularity)) {
+        for (size_t i = 0; i < count; ++i)
+          written_.push_back(reinterpret_cast<uintptr_t>(addresses_[i]));
+      }
+    }
+    written_.reserve(written_.size() + dirty_.size());
+
+    // pages are protected before being marked clean, so concurrent writes are reported next poll;
+    // neighbouring pages sharing protection take a single call. A write faulting on a busy page is
+    // only retried, so every page of a run is released before anything else is written.
+    for (size_t i = 0; i < dirty_.size();) {
+      auto run = i + 1;
+      while (run < dirty_.size() && dirty_[run]->protect == dirty_[i]->protect &&
+             dirty_[run]->address == dirty_[run - 1]->address + kPageSize)
+        ++run;
+      for (auto j = i; j < run; ++j)
+        Acquire_(*dirty_[j]);
+      ulong_t old;
+      VirtualProtect(reinterpret_cast<pvoid_t>(dirty_[i]->address), (run - i) * kPageSize, ReadOnly_(dirty_[i]->protect), &old);
+      for (auto j = i; j < run; ++j) {
+        dirty_[j]->isDirty = false;
+        dirty_[j]->isBusy.clear(memory_order_release);
+      }
+      for (; i < run; ++i)
+        written_.push_back(dirty_[i]->address);
+    }
+
+    sort(written_.begin(), written_.end());
+    return vector<Pointer>(written_.begin(), written_.end());
+  }
+
+  /**
+    @brief  Gets amount of watched bytes
+    @retval Bytes in every watched page
+  **/
+  size_t GetSize() const
+  {
+    lock_guard<mutex> lock(mutex_);
+    size_t size = 0;
+    for (auto& range : ranges_)
+      size += range.size;
+    return size;
+  }
+
+private:
+  /**
+    @brief Allocator placing watch bookkeeping in pages of its own, which Add refuses to watch
+  **/
+  template<class T>
+  struct Allocator_ {
+    using value_type = T;
+
+    Allocator_() = default;
+
+    template<class U>
+    Allocator_(const Allocator_<U>&) noexcept {}
+
+    T* allocate(const size_t count)
+    {
+      auto size = (count * sizeof(T) + kPageSize - 1) & ~(kPageSize - 1);
+      auto memory = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+      if (!memory)
+        throw bad_alloc();
+      lock_guard<mutex> lock(ownedMutex_);
+      owned_.emplace(reinterpret_cast<uintptr_t>(memory), size);
+      return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, const size_t) noexcept
+    {
+      {
+        lock_guard<mutex> lock(ownedMutex_);
+        owned_.erase(reinterpret_cast<uintptr_t>(memory));
+      }
+      VirtualFree(memory, 0, MEM_RELEASE);
+    }
+
+    template<class U>
+    bool operator==(const Allocator_<U>&) const noexcept
+    {
+      return true;
+    }
+  };
+
+  /**
+    @brief Page watched through protection faults
+  **/
+  struct Page_ {
+    uintptr_t    address;
+    ulong_t      protect; //!< Protection before watching
+    atomic<bool> isDirty; //!< Written since last poll, writable until then
+    atomic_flag  isBusy;  //!< Protection being changed
+  };
+
+  using Pages_ = vector<Page_, Allocator_<Page_>>;
+
+  /**
+    @brief Pages given to a single Add call
+  **/
+  struct Range_ {
+    uintptr_t base;
+    size_t    size;
+    Pages_    pages; //!< Pages watched through faults, empty if tracked by the system
+  };
+
+  using Table_ = vector<Page_*, Allocator_<Page_*>>;
+
+  vector<Range_, Allocator_<Range_>>       ranges_;
+  Table_                                   dirty_;     //!< Pages written since last poll, filled by Poll
+  vector<uintptr_t, Allocator_<uintptr_t>> written_;   //!< Written page addresses, filled by Poll
+  vector<pvoid_t, Allocator_<pvoid_t>>     addresses_; //!< Pages reported by GetWriteWatch, filled by Poll
+
+  static inline mutex                  ownedMutex_;
+  static inline map<uintptr_t, size_t> owned_;               //!< Pages held by Allocator_, by base address
+  static inline mutex                  mutex_;
+  static inline vector<WriteWatch*>    watches_;
+  static inline pvoid_t                handler_ = nullptr;
+  static inline atomic<const Table_*>  table_ = new Table_(); //!< Pages of every watch sorted by address, never changed once published
+  static inline atomic<size_t>         readers_[2];           //!< Handlers searching table, per epoch parity, never watched
+  static inline atomic<size_t>         epoch_;                //!< Publishing epoch
+
+  /**
+    @brief  Gets read-only counterpart of a protection
+    @param  protect Writable protection
+    @retval         Read-only protection, 0 if not writable
+  **/
+  static constexpr ulong_t ReadOnly_(const ulong_t protect) noexcept
+  {
+    auto modifiers = protect & ~0xFFu;
+    switch (protect & 0xFF) {
+    case PAGE_READWRITE:
+    case PAGE_WRITECOPY:
+      return PAGE_READONLY | modifiers;
+    case PAGE_EXECUTE_READWRITE:
+    case PAGE_EXECUTE_WRITECOPY:
+      return PAGE_EXECUTE_READ | modifiers;
+    default:
+      return 0;
+    }
+  }
+
+  /**
+    @brief Publishes new page table and frees previous one once no handler reads it
+    @param next Table to be published
+
+    Same two epochs wait as Settings::Watcher, handlers never block so the wait is short.
+  **/
+  static void Publish_(const Table_* next)
+  {
+    auto previous = table_.exchange(next);
+    for (auto phase = 0; phase < 2; ++phase) {
+      auto epoch = epoch_.fetch_add(1);
+      while (readers_[epoch & 1].load())
+        this_thread::yield();
+    }
+    delete previous;
+  }
+
+  /**
+    @brief  Check if a range overlaps pages written by the fault handler or held by Allocator_
+    @param  base Range start, aligned to a page
+    @param  size Amount of bytes
+    @retval bool Does range overlap?
+  **/
+  static bool IsOwned_(const uintptr_t base, const size_t size)
+  {
+    auto readers = reinterpret_cast<uintptr_t>(&readers_[0]);
+    if (readers < base + size && base < reinterpret_cast<uintptr_t>(&readers_[2]))
+      return true;
+
+    lock_guard<mutex> lock(ownedMutex_);
+    auto found = owned_.upper_bound(base);
+    if (found != owned_.begin() && prev(found)->first + prev(found)->second > base)
+      return true;
+    return found != owned_.end() && found->first < base + size;
+  }
+
+  static void Acquire_(Page_& page) noexcept
+  {
+    while (page.isBusy.test_and_set(memory_order_acquire))
+      this_thread::yield();
+  }
+
+  static bool Protect_(const Page_& page, const bool isWatched) noexcept
+  {
+    ulong_t old;
+    return VirtualProtect(reinterpret_cast<pvoid_t>(page.address), kPageSize, isWatched ? ReadOnly_(page.protect) : page.protect, &old);
+  }
+
+  /**
+    @brief Marks faulting page as written, never locks nor allocates
+
+    Runs on whatever thread faults, possibly while it holds the heap lock or a
+    lock of Add, Remove or Poll, so it only reads the published table.
+  **/
+  static LONG CALLBACK OnFault_(PEXCEPTION_POINTERS info)
+  {
+    auto record = info->ExceptionRecord;
+    if (record->ExceptionCode != EXCEPTION_ACCESS_VIOLATION || record->NumberParameters < 2 ||
+        record->ExceptionInformation[0] != 1)
+      return EXCEPTION_CONTINUE_SEARCH;
+
+    // registered reader keeps table and its pages alive
+    auto address = record->ExceptionInformation[1] & ~(kPageSize - 1);
+    auto readers = &readers_[epoch_.load() & 1];
+    readers->fetch_add(1);
+    auto table = table_.load();
+    auto found = lower_bound(table->begin(), table->end(), address,
+                             [](const Page_* page, const uintptr_t address) { return page->address < address; });
+
+    auto result = EXCEPTION_CONTINUE_SEARCH;
+    if (found != table->end() && (*found)->address == address) {
+      // a busy page is being protected by a poll, the write faults again once it is done;
+      // other threads may have faulted on the same page already
+      auto page = *found;
+      result = EXCEPTION_CONTINUE_EXECUTION;
+      if (!page->isBusy.test_and_set(memory_order_acquire)) {
+        page->isDirty = true;
+        if (!Protect_(*page, false))
+          result = EXCEPTION_CONTINUE_SEARCH;
+        page->isBusy.clear(memory_order_release);
+      }
+    }
+    else {
+      // pages removed while the fault was in flight are writable again, pages added meanwhile
+      // are in a newer table, either way the write is retried
+      MEMORY_BASIC_INFORMATION query;
+      if ((VirtualQuery(reinterpret_cast<pvoid_t>(address), &query, sizeof(query)) && query.State == MEM_COMMIT &&
+           ReadOnly_(query.Protect)) || table_.load() != table)
+        result = EXCEPTION_CONTINUE_EXECUTION;
+    }
+    readers->fetch_sub(1);
+    return result;
+  }
+};
+
+}
@@ -24,6 +24,8 @@
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 #include <dbgeng.h>
+#include <TlHelp32.h>
+#include <intrin.h>
 #include <wchar.h>
 #include <string>
 #include <iostream>
@@ -35,6 +37,17 @@
 #include <initializer_list>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <regex>
 #include <limits>
 #include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <bit>
+#include <functional>
+#include <algorithm>
+#include <span>
@@ -23,180 +23,158 @@
 
 #include "base.h"
 #include "settings/entry.h"
+#include "settings/parser.h"
+#include "settings/cache.h"
+#include "settings/schema.h"
 
 namespace Settings
 {
 
+/**
+  @class Config
+  @brief Object used to parse configuration files
+
+  Whole tree is kept inside a single arena of nodes, names and values are
+  views into the (comment stripped) source buffer.
+**/
 class Config {
 public:
-  Config(const path& filename) :
-    filename_(filename), file_(), head_(L"__g__"), buffer_()
+  /**
+    @brief Config object constructor
+    @param filename Path to config file
+    @param isCached Should a binary image be kept next to config file?
+
+    When cached and the image matches file content, the tree is used in
+    place from the mapped image without parsing anything.
+  **/
+  Config(const path& filename, const bool isCached = false) :
+    filename_(filename), buffer_(), arena_(), nodes_(nullptr), nodeCount_(0), source_(nullptr)
   {
-    file_.open(filename_);
-    Read_();
-    file_.close();
-    Parse_();
+    if (isCached) {
+      cache_ = make_unique<Cache>(filename_);
+      if (cache_->IsValid()) {
+        nodes_ = cache_->GetNodes();
+        nodeCount_ = cache_->GetHeader()->nodes;
+        source_ = cache_->GetSource();
+        return;
+      }
+    }
+
+    Read(filename_, buffer_);
+    arena_.reserve(count(buffer_.begin(), buffer_.end(), L'=') + 1);
+
+    Builder_ builder(arena_, buffer_.data());
+    Parse(buffer_, builder);
+    builder.Finish();
+
+    nodes_ = arena_.data();
+    nodeCount_ = arena_.size();
+    source_ = buffer_.data();
+    if (cache_) {
+      cache_->Write(filename_, arena_, buffer_);
+      cache_.reset();
+    }
   }
 
-  Entry& operator[](const wstring& name) noexcept
+  Config(const Config&) = delete;
+
+  /**
+    @brief  Gets global table
+    @retval Entry Root entry of config tree
+  **/
+  Entry GetHead() const noexcept
   {
-    return head_[name];
+    return { nodes_, source_, nodes_ + nodeCount_ - 1 };
   }
 
-private:
-  path      filename_;
-  wifstream file_;
-  Entry     head_;
-  wstring   buffer_;
-
-  void Read_()
+  /**
+    @brief  Checks if tree is being used from a binary image
+    @retval bool Was config loaded from cache?
+  **/
+  bool IsCached() const noexcept
   {
-    wchar_t buf[4] = {};
-    size_t count = 0;
-
-    while (file_.read(&buf[0], 4)) {
-      if (buf[1] == buf[0]) {
-        if (buf[0] == L'-') { // "--" single line comment
-          count += 4;
-          if (buf[2] != L'\n' && buf[3] != L'\n') {
-            for (; file_.get(buf[0]) && buf[0] != L'\n'; ++count);
-            file_.seekg(count);
-          }
-          buf[1] = L'\x20';
-          buf[2] = L'\x20';
-          continue;
-        }
-        else if (buf[0] == L'[' && buf[2] == L'-' && buf[3] == buf[2]) { // "[[--" multiline comment
-          while (file_.read(&buf[0], 4)) {
-            if (buf[1] == buf[0] && buf[3] == buf[2]) {
-              if (buf[0] == L'[' && buf[2] == L'-') // "[[--"
-                _throws("Found nested multiline comments");
-              if (buf[0] == L'-' && buf[2] == L']') { // "--]]"
-                count += 4;
-                file_.seekg(count);
-                break;
-              }
-            }
-            file_.seekg(++count);
-          }
-          continue;
-        }
-      }
-      buffer_ += buf[0];
-      file_.seekg(++count);
-    }
-    buffer_ += buf[0];
-    buffer_ += buf[1];
-    buffer_ += buf[2];
+    return (cache_ != nullptr);
   }
 
-  void Parse_()
+  Entry operator[](const wstring_view& name) const noexcept
   {
-    struct {
-      bool needsEntry = true;
-      bool foundEntry = false;
-      bool parsingEntry = false;
-      bool needsKey = false;
-      bool foundKey = false;
-      bool parsingKey = false;
-      bool parsingString = false;
-      bool foundTable = false;
-      bool parsingTable = false;
-    } state;
-    wstring entry, key;
-    list<Entry*> currentTable;
-    currentTable.push_back(&head_);
-
-    for (auto wch = buffer_.begin(); wch != buffer_.end(); ++wch) {
-      if (!state.parsingEntry && !state.parsingKey && iswspace(*wch))
-        continue;
-
-      if (state.foundTable && !state.parsingTable) {
-        currentTable.back()->Add({ entry });
-        currentTable.push_back(&currentTable.back()->GetTail());
-        entry.clear();
-
-        state.foundTable = false;
-        state.parsingTable = true;
-        state.foundEntry = false;
-        state.needsEntry = true;
-      }
+    return GetHead()[name];
+  }
 
-      if (state.needsEntry) {
-        if (*wch == L'}') { // end of table
-          state.parsingTable = false;
-          currentTable.pop_back();
-
-          if (currentTable.empty())
-            _throws("Unexpected end of table");
-          continue;
-        }
-
-        if (iswalpha(*wch) || *wch == L'_') { // restrict to valid names
-          entry += *wch;
-          state.parsingEntry = true;
-          continue;
-        }
-        else {
-          state.needsEntry = false;
-          state.parsingEntry = false;
-          state.foundEntry = true;
-        }
-      }
-      else if (state.needsKey) {
-        auto tmp = wch;
-        auto next = ((++tmp) != buffer_.end()) ? *tmp : L'\0';
-
-        if (*wch == L'{') { // start of table
-          state.needsKey = false;
-          state.foundTable = true;
-          continue;
-        }
-        else if (*wch == L'\'' || *wch == L'\"') { // start/end of string
-          state.parsingString = !state.parsingString;
-          continue;
-        }
-        else if ((*wch == L'[' || *wch == L']') && *wch == next) { // start/end of string
-          ++wch;
-          state.parsingString = !state.parsingString;
-          continue;
-        }
-
-        if (state.parsingString || iswalnum(*wch) || *wch == L'.' || *wch == L'-') {
-          key += *wch;
-          state.parsingKey = true;
-          continue;
-        }
-        else {
-          state.needsKey = false;
-          state.parsingKey = false;
-          state.foundKey = true;
-        }
-      }
+private:
+  /**
+    @class Builder_
+    @brief Parser handler used to lay tree out into the arena
+
+    Children of a table are only moved into the arena once the table ends,
+    so that every table owns a contiguous range of nodes.
+  **/
+  class Builder_ {
+  public:
+    Builder_(vector<Node>& arena, const wchar_t* source) :
+      arena_(arena), source_(source), name_(0), nameSize_(0)
+    {
+      tables_.emplace_back(numeric_limits<size_t>::max(), 0);
+    }
 
-      if (state.foundEntry && state.foundKey) {
-        state.foundEntry = false;
-        state.foundKey = false;
-        state.needsEntry = true;
+    void OnKey(const wstring_view& name)
+    {
+      name_ = static_cast<uint32_t>(name.data() - source_);
+      nameSize_ = static_cast<uint32_t>(name.size());
+    }
 
-        currentTable.back()->Add({ { entry, key } });
-        entry.clear();
-        key.clear();
-        continue;
-      }
-      else if (state.foundEntry && !state.needsKey && !iswspace(*wch)) {
-        if (*wch == L'=') {
-          state.needsKey = true;
-          continue;
-        }
-        else
-          _throws("Expected operator=");
-      }
+    void OnValue(const wstring_view& raw)
+    {
+      auto key = static_cast<uint32_t>(raw.data() - source_);
+      pending_.push_back({ name_, nameSize_, key, static_cast<uint32_t>(raw.size()), 0, 0, false });
+    }
 
-      if (iswpunct(*wch) && *wch != L',')
-        _throws("Unexpected character found while parsing");
+    void OnTableBegin()
+    {
+      pending_.push_back({ name_, nameSize_, 0, 0, 0, 0, true });
+      tables_.emplace_back(pending_.size() - 1, pending_.size());
     }
-  }
+
+    void OnTableEnd()
+    {
+      auto [table, first] = tables_.back();
+      tables_.pop_back();
+
+      pending_[table].first = static_cast<uint32_t>(arena_.size());
+      pending_[table].count = static_cast<uint32_t>(pending_.size() - first);
+      arena_.insert(arena_.end(), pending_.begin() + first, pending_.end());
+      pending_.resize(first);
+    }
+
+    /**
+      @brief Moves global table into arena
+    **/
+    void Finish()
+    {
+      auto first = static_cast<uint32_t>(arena_.size());
+      arena_.insert(arena_.end(), pending_.begin(), pending_.end());
+      arena_.push_back({ 0, 0, 0, 0, first, static_cast<uint32_t>(pending_.size()), true });
+    }
+
+  private:
+    vector<Node>&                arena_;
+    const wchar_t*               source_;
+    vector<Node>                 pending_;  //!< Nodes whose parent table is still open
+    vector<pair<size_t, size_t>> tables_;   //!< Open tables and their first pending child
+    uint32_t                     name_;     //!< Last key offset
+    uint32_t                     nameSize_; //!< Last key length
+  };
+
+  path              filename_;
+  wstring           buffer_;    //!< Source without comments
+  vector<Node>      arena_;     //!< Tree nodes, global table is the last one
+  unique_ptr<Cache> cache_;     //!< Mapped image, if tree was loaded from it
+  const Node*       nodes_;     //!< Tree nodes in use
+  size_t            nodeCount_; //!< Amount of nodes in use
+  const wchar_t*    source_;    //!< Source in use
 };
 
 }
+
+// submodules
+#include "settings/watcher.h"
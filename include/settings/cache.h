@@ -0,0 +1,273 @@
+/**
+  @brief     Settings cache submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "settings/entry.h"
+
+namespace Settings
+{
+
+/**
+  @class Cache
+  @brief Object used to map a binary image of a parsed config
+
+  Image holds a header, the node arena, and the comment stripped source,
+  laid out so the nodes can be used in place straight from the mapping.
+  It is only valid for the exact source content it was built from.
+
+  Windows refuses to replace a file that is still mapped, e.g. by the config
+  a Watcher is about to replace, so images alternate between kSlots files and
+  the first one matching the source is used.
+**/
+class Cache {
+public:
+  static constexpr size_t kSlots = 2; //!< Image files per source file
+
+  /**
+    @struct Header
+    @brief  Binary image header
+  **/
+  struct Header {
+    uint32_t magic;   //!< Image signature
+    uint32_t version; //!< Image layout version
+    uint64_t size;    //!< Source file size
+    uint64_t hash;    //!< Source file content hash
+    uint32_t nodes;   //!< Amount of nodes
+    uint32_t chars;   //!< Amount of source characters
+  };
+
+  /**
+    @brief Cache object constructor
+    @param filename Path to config source file
+
+    Maps image next to source file, image is left unused if it does not
+    match the current source content.
+  **/
+  Cache(const path& filename) :
+    file_(INVALID_HANDLE_VALUE), mapping_(nullptr), view_(nullptr), size_(0), hash_(0)
+  {
+    hash_ = Hash(filename, size_);
+    for (size_t slot = 0; slot < kSlots && !Open_(GetPath(filename, slot)); ++slot)
+      ;
+  }
+
+  Cache(const Cache&) = delete;
+
+  /**
+    @brief Cache object destructor
+  **/
+  ~Cache()
+  {
+    Close_();
+  }
+
+  /**
+    @brief  Checks if image matches source and can be used
+    @retval bool Is image valid?
+  **/
+  constexpr bool IsValid() const noexcept
+  {
+    return (view_ != nullptr);
+  }
+
+  const Header* GetHeader() const noexcept
+  {
+    return static_cast<const Header*>(view_);
+  }
+
+  const Node* GetNodes() const noexcept
+  {
+    return reinterpret_cast<const Node*>(GetHeader() + 1);
+  }
+
+  const wchar_t* GetSource() const noexcept
+  {
+    return reinterpret_cast<const wchar_t*>(GetNodes() + GetHeader()->nodes);
+  }
+
+  /**
+    @brief Writes image for source file
+    @param filename Path to config source file
+    @param arena    Parsed nodes
+    @param source   Comment stripped source
+    @note  Image is written aside and then moved over the first slot not mapped by
+           another config, failures are ignored
+  **/
+  void Write(const path& filename, const vector<Node>& arena, const wstring& source) const noexcept
+  {
+    try {
+      Header header = { magic_, version_, size_, hash_,
+                        static_cast<uint32_t>(arena.size()), static_cast<uint32_t>(source.size()) };
+      auto temporary = path(GetPath(filename)) += L".tmp";
+      bool isWritten;
+      {
+        ofstream file(temporary, ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(arena.data()), arena.size() * sizeof(Node));
+        file.write(reinterpret_cast<const char*>(source.data()), source.size() * sizeof(wchar_t));
+        isWritten = !file.fail();
+      }
+
+      error_code ec;
+      for (size_t slot = 0; isWritten && slot < kSlots; ++slot) {
+        rename(temporary, GetPath(filename, slot), ec);
+        if (!ec)
+          return;
+      }
+      remove(temporary, ec);
+    }
+    catch (const exception&) {
+    }
+  }
+
+  /**
+    @brief  Gets image path for source file
+    @param  filename Path to config source file
+    @param  slot     Image slot, below kSlots
+    @retval path     Path to image
+  **/
+  static path GetPath(const path& filename, const size_t slot = 0)
+  {
+    auto image = path(filename) += L".cache";
+    return (slot) ? image += to_wstring(slot) : image;
+  }
+
+  /**
+    @brief  Hashes file content
+    @param  filename Path to file
+    @param  size     Output file size
+    @retval uint64_t Content hash
+  **/
+  static uint64_t Hash(const path& filename, uint64_t& size)
+  {
+    size = file_size(filename);
+    if (!size)
+      return string_hash(string_view());
+
+    auto file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      _throws("Could not open file to hash");
+
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    auto view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    uint64_t hash = 0;
+    if (view != nullptr)
+      hash = string_hash(string_view(static_cast<const char*>(view), static_cast<size_t>(size)));
+
+    if (view != nullptr)
+      UnmapViewOfFile(view);
+    if (mapping != nullptr)
+      CloseHandle(mapping);
+    CloseHandle(file);
+
+    if (view == nullptr)
+      _throws("Could not map file to hash");
+    return hash;
+  }
+
+private:
+  static constexpr uint32_t magic_ = 0x434C5359u; //!< "YSLC"
+  static constexpr uint32_t version_ = 1u;
+
+  handle_t file_;    //!< Image file handle
+  handle_t mapping_; //!< Image mapping handle
+  pvoid_t  view_;    //!< Mapped image
+  uint64_t size_;    //!< Source file size
+  uint64_t hash_;    //!< Source file content hash
+
+  /**
+    @brief  Checks every node against image bounds, so a damaged image is parsed again
+    @retval bool Are all offsets and counts in range?
+
+    Children are stored before their table and the global table last, so
+    requiring children below their parent also rules out cycles.
+  **/
+  bool IsBodyValid_() const noexcept
+  {
+    auto header = GetHeader();
+    auto nodes = GetNodes();
+    for (uint32_t i = 0; i < header->nodes; ++i) {
+      auto& node = nodes[i];
+      auto isTable = *reinterpret_cast<const ubyte_t*>(&node.isTable);
+      if (isTable > 1 ||
+          static_cast<uint64_t>(node.name) + node.nameSize > header->chars ||
+          static_cast<uint64_t>(node.key) + node.keySize > header->chars ||
+          (!isTable && node.count) ||
+          (node.count && static_cast<uint64_t>(node.first) + node.count > i))
+        return false;
+    }
+    return *reinterpret_cast<const ubyte_t*>(&nodes[header->nodes - 1].isTable) == 1;
+  }
+
+  /**
+    @brief  Maps image file, closing it again if it does not match source
+    @param  image Path to image
+    @retval bool  Is image valid?
+  **/
+  bool Open_(const path& image) noexcept
+  {
+    file_ = CreateFileW(image.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER imageSize;
+    if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &imageSize) ||
+        imageSize.QuadPart < static_cast<long long>(sizeof(Header))) {
+      Close_();
+      return false;
+    }
+
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ != nullptr)
+      view_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (view_ == nullptr) {
+      Close_();
+      return false;
+    }
+
+    auto header = GetHeader();
+    auto expected = sizeof(Header) + static_cast<uint64_t>(header->nodes) * sizeof(Node) +
+                    static_cast<uint64_t>(header->chars) * sizeof(wchar_t);
+    if (header->magic != magic_ || header->version != version_ || header->size != size_ ||
+        header->hash != hash_ || !header->nodes || static_cast<uint64_t>(imageSize.QuadPart) < expected ||
+        !IsBodyValid_()) {
+      Close_();
+      return false;
+    }
+    return true;
+  }
+
+  void Close_() noexcept
+  {
+    if (view_ != nullptr)
+      UnmapViewOfFile(view_);
+    if (mapping_ != nullptr)
+      CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE)
+      CloseHandle(file_);
+    view_ = nullptr;
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+  }
+};
+
+}
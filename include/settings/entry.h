@@ -26,73 +26,82 @@
 namespace Settings
 {
 
+/**
+  @struct Node
+  @brief  Config tree node stored inside a flat arena
+
+  Nodes never own memory: names and raw values are ranges of the source
+  buffer and children are an index range of the arena they live in.
+**/
+struct Node {
+  uint32_t name;     //!< Name offset into source buffer
+  uint32_t nameSize; //!< Name length
+  uint32_t key;      //!< Raw value offset into source buffer
+  uint32_t keySize;  //!< Raw value length
+  uint32_t first;    //!< Index of first child inside arena
+  uint32_t count;    //!< Amount of children
+  bool     isTable;  //!< Is node a table?
+};
+
+/**
+  @class Entry
+  @brief Lightweight view of a config tree node
+  @note  Only valid while the object owning the arena is alive
+**/
 class Entry {
 public:
-  Entry(const wstring& name, const wstring& key) :
-    name_(name), key_(key), isTable_(false)
+  Entry(const Node* arena, const wchar_t* source, const Node* node) noexcept :
+    arena_(arena), source_(source), node_(node)
   {
   }
 
-  Entry(const wstring& name) :
-    name_(name), table_({}), isTable_(true)
+  const wstring_view GetName() const noexcept
   {
+    return { source_ + node_->name, node_->nameSize };
   }
 
-  Entry(const Entry& entry) :
-    name_(entry.name_), isTable_(entry.isTable_)
+  const wstring_view GetRaw() const noexcept
   {
-    if (isTable_)
-      table_.insert(table_.begin(), entry.table_.begin(), entry.table_.end());
-    else
-      key_ = entry.key_;
-  }
-
-  ~Entry()
-  {
-    name_.~basic_string();
-    if (isTable_)
-      table_.~list();
-    else
-      key_.~basic_string();
-  };
-
-  void Add(std::initializer_list<Entry> l) {
-    table_.insert(table_.end(), l.begin(), l.end());
+    return (node_->isTable) ? L"" : wstring_view(source_ + node_->key, node_->keySize);
   }
 
-  wstring& GetName() noexcept
+  constexpr bool IsTable() const noexcept
   {
-    return name_;
+    return node_->isTable;
   }
 
-  const wstring GetRaw() noexcept
+  /**
+    @brief  Gets amount of children
+    @retval size_t Children count, zero if not a table
+  **/
+  constexpr size_t Size() const noexcept
   {
-    return (isTable_) ? L"" : key_;
+    return node_->count;
   }
 
-  Entry& GetTail() noexcept
+  Entry GetChild(const size_t index) const
   {
-    return table_.back();
+    if (index >= node_->count)
+      _throws("Tried to access child out of table range");
+    return { arena_, source_, arena_ + node_->first + index };
   }
 
-  Entry& operator[](const wstring& name) noexcept
+  Entry operator[](const wstring_view& name) const noexcept
   {
-    if (isTable_) {
-      for (auto entry = table_.begin(); entry != table_.end(); ++entry) {
-        if (entry->GetName() == name)
-          return *entry;
+    if (node_->isTable) {
+      auto end = arena_ + node_->first + node_->count;
+      for (auto node = arena_ + node_->first; node != end; ++node) {
+        if (wstring_view(source_ + node->name, node->nameSize) == name)
+          return { arena_, source_, node };
       }
     }
     return *this;
   }
 
 private:
-  wstring name_;
-  union {
-    wstring     key_;
-    list<Entry> table_;
-  };
-  bool isTable_;
+  const Node*    arena_;  //!< First node of arena
+  const wchar_t* source_; //!< Source buffer
+  const Node*    node_;   //!< Node being viewed
 };
 
 }
@@ -0,0 +1,391 @@
+/**
+  @brief     Settings parser submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+
+
+namespace Settings
+{
+
+/**
+  @class Handler
+  @brief Interface for consumers of parser events
+  @note  Views passed are only valid during the call
+**/
+class Handler {
+public:
+  virtual ~Handler()
+  {
+  }
+
+  virtual void OnKey(const wstring_view&)
+  {
+  }
+
+  virtual void OnValue(const wstring_view&)
+  {
+  }
+
+  virtual void OnTableBegin()
+  {
+  }
+
+  virtual void OnTableEnd()
+  {
+  }
+};
+
+/**
+  @class Stripper
+  @brief Object used to remove comments from source, possibly split in chunks
+**/
+class Stripper {
+public:
+  Stripper() : isLine_(false), isBlock_(false)
+  {
+  }
+
+  /**
+    @brief  Strips comments from source
+    @param  source Source chunk
+    @param  out    Output, may alias source since output never outgrows input
+    @param  isLast Is it the last chunk?
+    @retval pair   Amount of characters consumed from source and written to out
+
+    Characters that may start a comment marker are left unconsumed unless
+    it is the last chunk, they must be passed again with the next chunk.
+  **/
+  pair<size_t, size_t> operator()(const wstring_view& source, wchar_t* out, const bool isLast)
+  {
+    size_t in = 0, written = 0;
+    while (in < source.size()) {
+      if (isBlock_) {
+        auto end = source.find(L"--]]", in);
+        if (source.substr(in, end - in).find(L"[[--") != wstring_view::npos)
+          _throws("Found nested multiline comments");
+        if (end == wstring_view::npos) { // keep what may be a split terminator
+          if (isLast)
+            in = source.size();
+          else if (source.size() - in > 3)
+            in = source.size() - 3;
+          break;
+        }
+        in = end + 4;
+        isBlock_ = false;
+        continue;
+      }
+      if (isLine_) {
+        in = _min(source.find(L'\n', in), source.size());
+        isLine_ = (in == source.size());
+        continue;
+      }
+
+      auto rest = source.substr(in);
+      if (rest.starts_with(L"[[--")) { // multiline comment
+        in += 4;
+        isBlock_ = true;
+        continue;
+      }
+      if (rest.starts_with(L"--")) { // single line comment
+        in += 2;
+        isLine_ = true;
+        continue;
+      }
+      if (!isLast && rest.size() < 4 &&
+          (wstring_view(L"[[--").starts_with(rest) || wstring_view(L"--").starts_with(rest)))
+        break;
+
+      out[written++] = source[in++];
+    }
+    return { in, written };
+  }
+
+private:
+  bool isLine_;  //!< Is inside single line comment?
+  bool isBlock_; //!< Is inside multiline comment?
+};
+
+/**
+  @class  Parser
+  @brief  Event driven parser for config sources without comments
+  @tparam H Handler type, must implement OnKey, OnValue, OnTableBegin, and OnTableEnd
+
+  Every value is preceded by its key, tables are reported as a key followed
+  by OnTableBegin and its entries, until the matching OnTableEnd.
+**/
+template<class H>
+class Parser {
+public:
+  Parser(H& handler) :
+    handler_(handler), source_(), pos_(0), entry_(0), entrySize_(0),
+    key_(0), keySize_(0), depth_(0)
+  {
+  }
+
+  /**
+    @brief Parses whole source at once
+    @param source Config source, views passed to handler point into it
+  **/
+  void Parse(const wstring_view& source)
+  {
+    source_ = source;
+    pos_ = 0;
+    Finish_();
+  }
+
+  /**
+    @brief Parses next chunk of source
+    @param source Config source chunk, copied as needed
+    @note  Only characters of unfinished elements are kept between calls
+  **/
+  void Feed(const wstring_view& source)
+  {
+    window_.append(source);
+    source_ = window_;
+    Run_(false);
+
+    auto keep = pos_;
+    if (entrySize_)
+      keep = _min(keep, entry_);
+    if (keySize_)
+      keep = _min(keep, key_);
+    window_.erase(0, keep);
+    pos_ -= keep;
+    entry_ -= (entrySize_) ? keep : 0;
+    key_ -= (keySize_) ? keep : 0;
+  }
+
+  /**
+    @brief Parses what was left from fed chunks
+  **/
+  void Finish()
+  {
+    source_ = window_;
+    Finish_();
+  }
+
+private:
+  struct {
+    bool needsEntry = true;
+    bool foundEntry = false;
+    bool parsingEntry = false;
+    bool needsKey = false;
+    bool foundKey = false;
+    bool parsingKey = false;
+    bool parsingString = false;
+    bool foundTable = false;
+  } state_;
+  H&           handler_;
+  wstring      window_;    //!< Unparsed characters from fed chunks
+  wstring_view source_;    //!< Source being parsed
+  size_t       pos_;       //!< Current position in source
+  size_t       entry_;     //!< Current name offset
+  size_t       entrySize_; //!< Current name length
+  size_t       key_;       //!< Current value offset
+  size_t       keySize_;   //!< Current value length
+  size_t       depth_;     //!< Amount of open tables
+
+  void Finish_()
+  {
+    Run_(true);
+    if (state_.foundEntry && state_.parsingKey)
+      handler_.OnValue(source_.substr(key_, keySize_));
+    if (depth_)
+      _throws("Expected end of table");
+  }
+
+  void EndTable_()
+  {
+    if (!depth_)
+      _throws("Unexpected end of table");
+    --depth_;
+    handler_.OnTableEnd();
+  }
+
+  void Run_(const bool isLast)
+  {
+    for (; pos_ < source_.size(); ++pos_) {
+      auto wch = source_[pos_];
+      if (!state_.parsingEntry && !state_.parsingKey && iswspace(wch))
+        continue;
+
+      if (state_.foundTable) {
+        ++depth_;
+        handler_.OnTableBegin();
+
+        state_.foundTable = false;
+        state_.foundEntry = false;
+        state_.needsEntry = true;
+      }
+
+      if (state_.needsEntry) {
+        if (wch == L'}') { // end of table
+          EndTable_();
+          continue;
+        }
+        if (wch == L',' && !entrySize_) // separator after a table
+          continue;
+
+        if (iswalpha(wch) || wch == L'_') { // restrict to valid names
+          if (!entrySize_)
+            entry_ = pos_;
+          ++entrySize_;
+          state_.parsingEntry = true;
+          continue;
+        }
+        else {
+          state_.needsEntry = false;
+          state_.parsingEntry = false;
+          state_.foundEntry = true;
+          handler_.OnKey(source_.substr(entry_, entrySize_));
+          entrySize_ = 0;
+        }
+      }
+      else if (state_.needsKey) {
+        if (pos_ + 1 == source_.size() && !isLast) // wait for next character
+          break;
+        auto next = (pos_ + 1 < source_.size()) ? source_[pos_ + 1] : L'\0';
+
+        if (wch == L'{') { // start of table
+          state_.needsKey = false;
+          state_.foundTable = true;
+          continue;
+        }
+        else if (wch == L'\'' || wch == L'\"') { // start/end of string
+          state_.parsingString = !state_.parsingString;
+          continue;
+        }
+        else if ((wch == L'[' || wch == L']') && wch == next) { // start/end of string
+          ++pos_;
+          state_.parsingString = !state_.parsingString;
+          continue;
+        }
+
+        if (state_.parsingString || iswalnum(wch) || wch == L'.' || wch == L'-') {
+          if (!keySize_)
+            key_ = pos_;
+          keySize_ = pos_ + 1 - key_;
+          state_.parsingKey = true;
+          continue;
+        }
+        else {
+          state_.needsKey = false;
+          state_.parsingKey = false;
+          state_.foundKey = true;
+        }
+      }
+
+      if (state_.foundEntry && state_.foundKey) {
+        state_.foundEntry = false;
+        state_.foundKey = false;
+        state_.needsEntry = true;
+
+        handler_.OnValue(source_.substr(key_, keySize_));
+        keySize_ = 0;
+        if (wch == L'}') // value terminated by end of table
+          EndTable_();
+        continue;
+      }
+      else if (state_.foundEntry && !state_.needsKey && !iswspace(wch)) {
+        if (wch == L'=') {
+          state_.needsKey = true;
+          continue;
+        }
+        else
+          _throws("Expected operator=");
+      }
+
+      if (iswpunct(wch) && wch != L',')
+        _throws("Unexpected character found while parsing");
+    }
+  }
+};
+
+/**
+  @brief Reads whole config file into buffer without comments
+  @param filename Path to config file
+  @param buffer   Output buffer, comments are stripped in place
+**/
+inline void Read(const path& filename, wstring& buffer)
+{
+  auto size = file_size(filename);
+  if (size > numeric_limits<uint32_t>::max())
+    _throws("Config file is too large");
+
+  wifstream file(filename);
+  buffer.resize(static_cast<size_t>(size));
+  file.read(buffer.data(), buffer.size());
+  buffer.resize(static_cast<size_t>(file.gcount()));
+
+  Stripper stripper;
+  buffer.resize(stripper(buffer, buffer.data(), true).second);
+}
+
+/**
+  @brief Parses whole config source at once
+  @param source  Config source without comments
+  @param handler Handler object, views passed to it point into source
+**/
+template<class H>
+void Parse(const wstring_view& source, H& handler)
+{
+  Parser<H> parser(handler);
+  parser.Parse(source);
+}
+
+/**
+  @brief Streams config file through handler without loading it whole
+  @param filename  Path to config file
+  @param handler   Handler object (e.g. derived from Settings::Handler)
+  @param chunkSize Amount of characters read at once
+
+  Memory use is bound by chunk size and the longest element, so large
+  configs can be consumed (e.g. hooks installed) while still being read.
+**/
+template<class H>
+void Stream(const path& filename, H& handler, const size_t chunkSize = 0x10000)
+{
+  wifstream file(filename);
+  if (!file.is_open())
+    _throws("Could not open config file");
+
+  wstring chunk(_max(chunkSize, 16u), L'\0');
+  Stripper stripper;
+  Parser<H> parser(handler);
+  size_t carry = 0;
+  bool isLast = false;
+  while (!isLast) {
+    file.read(chunk.data() + carry, chunk.size() - carry);
+    auto size = carry + static_cast<size_t>(file.gcount());
+    isLast = file.eof();
+
+    auto [consumed, written] = stripper({ chunk.data(), size }, chunk.data(), isLast);
+    parser.Feed({ chunk.data(), written });
+
+    carry = size - consumed;
+    copy(chunk.begin() + consumed, chunk.begin() + size, chunk.begin());
+  }
+  parser.Finish();
+}
+
+}
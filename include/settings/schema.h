@@ -0,0 +1,177 @@
+/**
+  @brief     Settings schema submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "settings/parser.h"
+
+namespace Settings
+{
+
+/**
+  @brief  Converts raw config value
+  @tparam V   Output type: bool, integral, floating point, or constructible from a wide string
+  @param  raw Raw value
+  @param  out Output value
+**/
+template<typename V>
+void Convert(const wstring_view& raw, V& out)
+{
+  if constexpr (is_same_v<V, bool>)
+    out = (raw == L"true");
+  else if constexpr (is_arithmetic_v<V>) {
+    wchar_t buffer[64] = {};
+    if (raw.size() >= size(buffer))
+      _throws("Numeric value is too long");
+    raw.copy(buffer, raw.size());
+
+    wchar_t* end = nullptr;
+    if constexpr (is_floating_point_v<V>)
+      out = static_cast<V>(wcstod(buffer, &end));
+    else if constexpr (is_signed_v<V>)
+      out = static_cast<V>(wcstoll(buffer, &end, 0));
+    else
+      out = static_cast<V>(wcstoull(buffer, &end, 0));
+
+    if (end == buffer)
+      _throws("Could not convert value into number");
+  }
+  else if constexpr (is_constructible_v<V, wstring_view>)
+    out = V(raw);
+  else
+    static_assert(!is_same_v<V, V>, "Unsupported field type");
+}
+
+/**
+  @struct Field
+  @brief  Binds a config key to a struct member
+  @tparam T Struct type
+  @tparam V Member type
+**/
+template<class T, typename V>
+struct Field {
+  uint64_t hash;   //!< Hash of dot separated key path (e.g. "map.size")
+  V T::*   member; //!< Bound member
+
+  consteval Field(const wchar_t* key, V T::* member_) :
+    hash(string_hash(wstring_view(key))), member(member_)
+  {
+  }
+};
+
+/**
+  @class  Schema
+  @brief  Object used to parse configuration files straight into a struct
+  @tparam T Struct type
+  @tparam F Field types
+
+  No tree is built, keys are matched against the hashes computed when the
+  schema was declared and values are written into the struct as they are
+  parsed. Keys not present in the schema are ignored.
+**/
+template<class T, class... F>
+class Schema {
+public:
+  constexpr Schema(const F&... fields) : fields_(fields...)
+  {
+  }
+
+  /**
+    @brief Parses file into struct
+    @param filename Path to config file
+    @param out      Struct to be written
+  **/
+  void Load(const path& filename, T& out) const
+  {
+    wstring buffer;
+    Read(filename, buffer);
+
+    Binder_ binder(*this, out);
+    Parse(buffer, binder);
+  }
+
+  T Load(const path& filename) const
+  {
+    T out{};
+    Load(filename, out);
+    return out;
+  }
+
+private:
+  tuple<F...> fields_;
+
+  /**
+    @class Binder_
+    @brief Parser handler used to keep track of key path hashes
+  **/
+  class Binder_ {
+  public:
+    Binder_(const Schema& schema, T& out) :
+      schema_(schema), out_(out), key_(0)
+    {
+      path_.push_back(string_hash(wstring_view()));
+    }
+
+    void OnKey(const wstring_view& name)
+    {
+      key_ = string_hash(name, path_.back());
+    }
+
+    void OnValue(const wstring_view& raw)
+    {
+      schema_.Assign_(key_, raw, out_);
+    }
+
+    void OnTableBegin()
+    {
+      path_.push_back(string_hash(L".", key_));
+    }
+
+    void OnTableEnd()
+    {
+      path_.pop_back();
+    }
+
+  private:
+    const Schema&    schema_;
+    T&               out_;
+    vector<uint64_t> path_; //!< Hash of each open table path
+    uint64_t         key_;  //!< Hash of last key path
+  };
+
+  template<size_t I = 0>
+  void Assign_(const uint64_t hash, const wstring_view& raw, T& out) const
+  {
+    if constexpr (I < sizeof...(F)) {
+      auto& field = get<I>(fields_);
+      if (field.hash == hash)
+        Convert(raw, out.*field.member);
+      else
+        Assign_<I + 1>(hash, raw, out);
+    }
+  }
+};
+
+template<class T, typename... V>
+Schema(const Field<T, V>&...) -> Schema<T, Field<T, V>...>;
+
+}
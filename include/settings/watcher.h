@@ -0,0 +1,219 @@
+/**
+  @brief     Settings watcher submodule
+  @author    Augusto Goulart
+  @date      18.10.2026
+  @copyright   Copyright (c) 2026 Augusto Goulart
+               Permission is hereby granted, free of charge, to any person obtaining a copy
+               of this software and associated documentation files (the "Software"), to deal
+               in the Software without restriction, including without limitation the rights
+               to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+               copies of the Software, and to permit persons to whom the Software is
+               furnished to do so, subject to the following conditions:
+               The above copyright notice and this permission notice shall be included in all
+               copies or substantial portions of the Software.
+               THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+               IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+               FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+               AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+               LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+               OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+               SOFTWARE.
+**/
+#pragma once
+
+#include "base.h"
+#include "settings.h"
+
+namespace Settings
+{
+
+/**
+  @class Watcher
+  @brief Object used to keep an up to date config snapshot
+
+  Once started, config file directory is watched in background, whenever the file
+  changes it gets parsed into a new Config which is then published atomically. A
+  reload that fails to parse keeps the previous snapshot.
+**/
+class Watcher {
+public:
+  /**
+    @class Snapshot
+    @brief Guard keeping a published config alive while in use
+
+    Taking a snapshot never locks, it only increments a reader counter.
+    Snapshots are meant to be short lived, a reload waits for the readers
+    of the previous config before freeing it.
+  **/
+  class Snapshot {
+  public:
+    Snapshot(const Watcher& watcher) noexcept
+    {
+      auto epoch = watcher.epoch_.load();
+      readers_ = &watcher.readers_[epoch & 1];
+      readers_->fetch_add(1);
+      config_ = watcher.current_.load();
+    }
+
+    Snapshot(const Snapshot&) = delete;
+
+    ~Snapshot()
+    {
+      readers_->fetch_sub(1);
+    }
+
+    const Config& operator*() const noexcept
+    {
+      return *config_;
+    }
+
+    const Config* operator->() const noexcept
+    {
+      return config_;
+    }
+
+  private:
+    atomic<size_t>* readers_; //!< Counter this reader is registered at
+    const Config*   config_;  //!< Config being read
+  };
+
+  /**
+    @brief Watcher object constructor, file is only watched once started
+    @param filename Path to config file, parsed before returning
+    @param isCached Should configs keep a binary image next to the file?
+  **/
+  Watcher(const path& filename, const bool isCached = false) :
+    filename_(filename), isCached_(isCached), current_(new Config(filename, isCached)),
+    epoch_(0), reloads_(0)
+  {
+    stop_ = CreateEventW(nullptr, true, false, nullptr);
+    if (stop_ == nullptr) {
+      delete current_.load();
+      _throws("Could not create watcher event");
+    }
+  }
+
+  Watcher(const Watcher&) = delete;
+
+  /**
+    @brief Watcher object destructor
+    @note  Joins watching thread, so it must be stopped beforehand when destroyed from DllMain
+  **/
+  ~Watcher()
+  {
+    Stop();
+    CloseHandle(stop_);
+    delete current_.load();
+  }
+
+  /**
+    @brief Starts watching file in background, does nothing if already watching
+    @note  Must not be called from DllMain, thread can not start while loader lock is held
+  **/
+  void Start()
+  {
+    if (thread_.joinable())
+      return;
+    ResetEvent(stop_);
+    thread_ = thread(&Watcher::Watch_, this);
+  }
+
+  /**
+    @brief Stops watching file
+    @param isWaiting Should watching thread be joined?
+    @note  Exiting threads need loader lock, so DllMain may only stop without waiting.
+           Watcher must then be kept alive, as the thread may still be running.
+  **/
+  void Stop(const bool isWaiting = true)
+  {
+    if (!thread_.joinable())
+      return;
+    SetEvent(stop_);
+    if (isWaiting)
+      thread_.join();
+    else
+      thread_.detach();
+  }
+
+  /**
+    @brief  Gets current config
+    @retval Snapshot Guard to current config
+  **/
+  Snapshot Get() const noexcept
+  {
+    return { *this };
+  }
+
+  /**
+    @brief  Gets amount of successful reloads
+    @retval size_t Reload count
+  **/
+  size_t GetReloads() const noexcept
+  {
+    return reloads_.load();
+  }
+
+private:
+  path                   filename_;
+  bool                   isCached_;   //!< Are configs cached?
+  atomic<const Config*>  current_;    //!< Published config
+  mutable atomic<size_t> readers_[2]; //!< Reader count per epoch parity
+  atomic<size_t>         epoch_;      //!< Publishing epoch
+  atomic<size_t>         reloads_;    //!< Successful reloads
+  handle_t               stop_;       //!< Event signaled on destruction
+  thread                 thread_;     //!< Watching thread
+
+  /**
+    @brief Publishes new config and frees previous one once unused
+    @param next Config to be published
+
+    Epoch is advanced twice, the first wait drains readers that may have
+    picked previous config, the second one drains those who registered
+    with a stale epoch before the first advance.
+  **/
+  void Publish_(const Config* next)
+  {
+    auto previous = current_.exchange(next);
+    for (auto phase = 0; phase < 2; ++phase) {
+      auto epoch = epoch_.fetch_add(1);
+      while (readers_[epoch & 1].load())
+        this_thread::yield();
+    }
+    delete previous;
+    ++reloads_;
+  }
+
+  void Watch_()
+  {
+    auto directory = filename_.parent_path();
+    if (directory.empty())
+      directory = L".";
+
+    auto change = FindFirstChangeNotificationW(directory.c_str(), false,
+                                               FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+    if (change == INVALID_HANDLE_VALUE)
+      return;
+
+    error_code ec;
+    auto lastWrite = last_write_time(filename_, ec);
+    handle_t handles[] = { stop_, change };
+    while (WaitForMultipleObjects(2, handles, false, INFINITE) == WAIT_OBJECT_0 + 1) {
+      auto time = last_write_time(filename_, ec);
+      if (!ec && time != lastWrite) {
+        try {
+          auto next = make_unique<Config>(filename_, isCached_);
+          Publish_(next.release());
+          lastWrite = time;
+        }
+        catch (const exception&) {
+          // file may still be being written, try again on next change
+        }
+      }
+      if (!FindNextChangeNotification(change))
+        break;
+    }
+    FindCloseChangeNotification(change);
+  }
+};
+
+}
@@ -41,10 +41,13 @@ class YASL {
   YASL();
   ~YASL();
 
+  void Start();
+  void Stop(const bool isWaiting);
+
 private:
   list<Script>       scripts_;       // TODO: create script pool object
   unique_ptr<Status> status_;        //!< Pointer to status object
-  unique_ptr<Settings::Config> config_;
+  unique_ptr<Settings::Watcher> config_;
   unique_ptr<Memory::Trampoline<int>> trampoline_;
 
   const path configFile_ = L"./yasl.lua";    //!< Configure file path
@@ -58,4 +61,5 @@ static YASL* hYasl_; // need this from program start until termination
 static void Start();
 static void End();
 extern "C" void Dummy();
+extern "C" void Shutdown();
 int Run();
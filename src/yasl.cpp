@@ -55,10 +55,28 @@ static void Start()
 
 /**
   @brief Terminate trampoline
+  @note  Runs under loader lock, so background threads are only signaled, not joined
 **/
 static void End()
 {
-  delete hYasl_;
+  if (hYasl_ != nullptr) {
+    hYasl_->Stop(false);
+    delete hYasl_;
+    hYasl_ = nullptr;
+  }
+}
+
+/**
+  @brief Stops background threads and terminates trampoline, to be called before FreeLibrary
+**/
+void Shutdown()
+{
+  if (hYasl_ != nullptr) {
+    hYasl_->Stop(true);
+    delete hYasl_;
+    hYasl_ = nullptr;
+  }
+  Memory::WorkerPool::Get().Stop();
 }
 
 /**
@@ -67,7 +85,7 @@ static void End()
 YASL::YASL()
 {
   status_ = make_unique<Status>(logFile_, projectName_, projectVersion_);
-  config_ = make_unique<Settings::Config>(configFile_);
+  config_ = make_unique<Settings::Watcher>(configFile_, true);
   status_->LogMessage(L"Loading and parsing configuration file");
   //LoadScripts_();
 
@@ -85,6 +103,29 @@ YASL::~YASL()
   status_->LogMessage(L"Returning to entry point");
 }
 
+/**
+  @brief Starts background threads, called from entry point once loader lock is released
+**/
+void YASL::Start()
+{
+  if (config_)
+    config_->Start();
+}
+
+/**
+  @brief Stops background threads
+  @param isWaiting Should threads be joined? Never true under loader lock
+**/
+void YASL::Stop(const bool isWaiting)
+{
+  if (!config_)
+    return;
+  config_->Stop(isWaiting);
+  // thread may still be running, so watcher outlives this object
+  if (!isWaiting)
+    config_.release();
+}
+
 /* TODO: move to Scripts module
 bool YASL::IsFileExtSupported_(const path& filename) const
 {
@@ -133,6 +174,8 @@ void Dummy()
 
 int Run()
 {
+  if (hYasl_ != nullptr)
+    hYasl_->Start();
   MessageBox(nullptr, L"hook has been moved", L"no crashorino", 0);
   return 0;
 }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "memory.h"
+
+static void DecodeLengths()
+{
+  const vector<pair<vector<ubyte_t>, size_t>> x64 = {
+    { { 0x48, 0x89, 0x5C, 0x24, 0x08 }, 5 },                               // mov [rsp+8], rbx
+    { { 0x48, 0x83, 0xEC, 0x28 }, 4 },                                     // sub rsp, 28h
+    { { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44 }, 7 },                   // mov rax, [rip+disp32]
+    { { 0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8 }, 10 },                        // mov rax, imm64
+    { { 0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00 }, 6 },                         // nop word [rax+rax]
+    { { 0xC5, 0xF8, 0x77 }, 3 },                                           // vzeroupper
+    { { 0xC4, 0xE3, 0x7D, 0x18, 0xC1, 0x01 }, 6 },                         // vinsertf128 ymm0, ymm0, xmm1, 1
+    { { 0x0F, 0x84, 0x11, 0x22, 0x33, 0x44 }, 6 },                         // je rel32
+    { { 0xF7, 0x05, 1, 2, 3, 4, 5, 6, 7, 8 }, 10 },                        // test [rip+disp32], imm32
+    { { 0x40, 0x53 }, 2 },                                                 // push rbx
+  };
+  for (auto& [code, length] : x64) {
+    auto padded = code;
+    padded.resize(16, 0xCC);
+    _asserts(Memory::DecodeLength(padded.data(), true) == length, "Wrong x64 instruction length");
+  }
+
+  const vector<pair<vector<ubyte_t>, size_t>> x86 = {
+    { { 0x55 }, 1 },                                                       // push ebp
+    { { 0x8B, 0xEC }, 2 },                                                 // mov ebp, esp
+    { { 0x40 }, 1 },                                                       // inc eax
+    { { 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00 }, 6 },                         // sub esp, 100h
+    { { 0xA1, 1, 2, 3, 4 }, 5 },                                           // mov eax, [moffs32]
+    { { 0x67, 0x8B, 0x46, 0x10 }, 4 },                                     // mov eax, [bp+10h]
+  };
+  for (auto& [code, length] : x86) {
+    auto padded = code;
+    padded.resize(16, 0xCC);
+    _asserts(Memory::DecodeLength(padded.data(), false) == length, "Wrong x86 instruction length");
+  }
+
+  // push rbx; sub rsp, 20h; covers a 5 byte jump with 6 bytes
+  ubyte_t prologue[32] = { 0x40, 0x53, 0x48, 0x83, 0xEC, 0x20, 0x48, 0x8B, 0xD9, 0xCC };
+  if (sizeof(pvoid_t) == 8)
+    _asserts(Memory::DecodePrologue(prologue, 5) == 6, "Prologue does not cover whole instructions");
+}
+
+static ubyte_t analysedCode_[64] = { 0x40, 0x53, 0x48, 0x83, 0xEC, 0x20, 0x48, 0x8B, 0xD9, 0x48, 0x8B, 0x05 };
+
+static void CacheAnalysis()
+{
+  const path file = L"./analysis.cache";
+  remove(file);
+  Memory::Process p;
+  auto target = Memory::Pointer::FromObject(analysedCode_);
+
+  size_t calls = 0;
+  auto resolver = [&] {
+    ++calls;
+    return target;
+  };
+  {
+    Memory::Analysis analysis(p.GetBaseModule(), file);
+    auto resolved = analysis.Resolve("analysedCode", resolver);
+    _asserts(resolved.address == target && resolved.prologue, "Target was not resolved");
+    _asserts(calls == 1 && analysis.GetMisses() == 1, "Cold start did not call resolver once");
+  }
+  {
+    // warm start, resolver is not called
+    Memory::Analysis analysis(p.GetBaseModule(), file);
+    auto resolved = analysis.Resolve("analysedCode", resolver);
+    _asserts(resolved.address == target, "Cached target differs");
+    _asserts(calls == 1 && analysis.GetHits() == 1, "Warm start called resolver");
+  }
+
+  // changed bytes make target stale
+  analysedCode_[1] = 0x55;
+  {
+    Memory::Analysis analysis(p.GetBaseModule(), file);
+    auto resolved = analysis.Resolve("analysedCode", resolver);
+    _asserts(resolved.address == target, "Stale target was not resolved again");
+    _asserts(calls == 2 && analysis.GetMisses() == 1, "Stale target was trusted");
+  }
+  remove(file);
+}
+
+void AnalysisTest()
+{
+  DecodeLengths();
+  CacheAnalysis();
+}
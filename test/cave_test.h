@@ -0,0 +1,78 @@
+#pragma once
+
+#include "memory.h"
+
+static void FindPadding()
+{
+  auto code = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+  _asserts(code, "Page was not allocated");
+  memset(code, 0x48, 0x1000);
+  memset(code + 100, 0xCC, 20);
+  code[299] = 0xC3;
+  memset(code + 300, 0x90, 40);
+  memset(code + 500, 0x90, 40); // alignment inside a function, may be executed
+  memset(code + 600, 0x00, 40); // may be data
+  memset(code + 700, 0xCC, 15);
+  memset(code + 0xF00, 0x00, 0x100);
+
+  auto caves = Memory::FindCaves(code, 0x1000, 16);
+  _asserts(caves.size() == 3, "Caves were not found");
+  _asserts(caves[0].address == Memory::Pointer(code + 100) && caves[0].size == 20 && caves[0].filler == 0xCC,
+           "Int3 run was not found");
+  _asserts(caves[1].address == Memory::Pointer(code + 300) && caves[1].size == 40 && caves[1].filler == 0x90,
+           "Nop run after ret was not found");
+  _asserts(caves[2].address == Memory::Pointer(code + 0xF00) && caves[2].size == 0x100 && !caves[2].filler,
+           "Zero run at range end was not found");
+  _asserts(Memory::FindCaves(code, 0x1000, 64).size() == 1, "Small caves were kept");
+
+  // executable sections of a module only hold caves made of padding, on mapped pages
+  Memory::Process p;
+  Memory::MemoryMap map;
+  for (auto& cave : Memory::FindCaves(p.GetBaseModule(), 8)) {
+    _asserts(cave.size >= 8 && map.IsReadable(cave.address, cave.size), "Module cave is not mapped");
+    for (size_t i = 0; i < cave.size; ++i)
+      _asserts(cave.address.ToAny<ubyte_t*>()[i] == cave.filler, "Module cave holds code");
+  }
+  VirtualFree(code, 0, MEM_RELEASE);
+}
+
+static void PoolCaves()
+{
+  auto code = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+  _asserts(code, "Page was not allocated");
+  memset(code, 0x48, 0x1000);
+  memset(code + 0x100, 0xCC, 0x40);
+
+  Memory::CavePool pool(Memory::FindCaves(code, 0x1000));
+  _asserts(pool.GetFree().size() == 1 && pool.GetFreeSize() == 0x40, "Cave was not pooled");
+
+  auto first = pool.Allocate(0x10, code);
+  auto second = pool.Allocate(0x10, code);
+  _asserts(first == Memory::Pointer(code + 0x100) && second == Memory::Pointer(code + 0x110),
+           "Pieces were not cut from cave start");
+  _asserts(pool.GetFreeSize() == 0x20, "Allocated pieces were not taken");
+  auto piece = pool.Allocate(0x21);
+  _asserts(piece == Memory::Pointer(nullptr), "Oversized piece was allocated");
+  if (sizeof(pvoid_t) == 8) {
+    piece = pool.Allocate(0x10, reinterpret_cast<ubyte_t*>(code) + 0x100000000ull);
+    _asserts(piece == Memory::Pointer(nullptr), "Unreachable piece was allocated");
+  }
+
+  // freed pieces get padding back and merge with their neighbours
+  memset(first.ToAny<ubyte_t*>(), 0xC3, 0x10);
+  auto isFreed = pool.Free(first);
+  _asserts(isFreed && code[0x100] == 0xCC && code[0x10F] == 0xCC, "Freed piece did not get padding back");
+  isFreed = pool.Free(first);
+  _asserts(!isFreed, "Piece was freed twice");
+  isFreed = pool.Free(second);
+  _asserts(isFreed && pool.GetFree().size() == 1 && pool.GetFreeSize() == 0x40, "Freed pieces were not merged");
+  piece = pool.Allocate(0x40);
+  _asserts(piece == Memory::Pointer(code + 0x100), "Merged cave was not allocated");
+  VirtualFree(code, 0, MEM_RELEASE);
+}
+
+void CaveTest()
+{
+  FindPadding();
+  PoolCaves();
+}
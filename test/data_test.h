@@ -0,0 +1,97 @@
+#pragma once
+
+#include "memory.h"
+
+static void BuildData()
+{
+  Memory::Data small = { 0x48, 0x8B, 0xC1 };
+  _asserts(small.Size() == 3 && small.Capacity() == Memory::Data::kInlineSize, "Small data was not kept inline");
+  _asserts(small[0] == 0x48 && small[2] == 0xC1, "Initializer bytes differ");
+
+  small.PushObject<uint32_t>(0xDEADBEEF);
+  _asserts(small.Size() == 7 && small.ReadObject<uint32_t>(3) == 0xDEADBEEF, "Pushed object differs");
+  auto popped = small.PopObject<uint32_t>();
+  _asserts(popped == 0xDEADBEEF && small.Size() == 3, "Popped object differs");
+
+  // grows onto heap once inline buffer is full
+  Memory::Data large;
+  large.Reserve(0x100);
+  _asserts(large.Capacity() == 0x100, "Reserve did not grow capacity");
+  for (ubyte_t i = 0; i < 100; ++i)
+    large.PushObject(i);
+  _asserts(large.Size() == 100 && large.Capacity() == 0x100 && large[99] == 99, "Pushes within capacity reallocated");
+
+  large += large;
+  _asserts(large.Size() == 200 && large[150] == 50, "Appending data to itself failed");
+
+  Memory::Data copy = large;
+  Memory::Data moved = move(copy);
+  _asserts(moved.Size() == 200 && moved[199] == 99 && !copy.Size(), "Moved data differs");
+  moved = small;
+  _asserts(moved.Size() == 3 && moved[1] == 0x8B, "Assigned data differs");
+
+  auto threw = false;
+  try {
+    small[3];
+  }
+  catch (const runtime_error&) {
+    threw = true;
+  }
+  _asserts(threw, "Out of bounds access did not throw");
+}
+
+static void ReadWriteData()
+{
+  ubyte_t code[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  Memory::Pointer ptr = code;
+
+  Memory::Data data;
+  Read(ptr, data, sizeof(code), false);
+  _asserts(data.Size() == sizeof(code) && data[7] == 8, "Read bytes differ");
+
+  Memory::Data patch = { 0x90, 0x90 };
+  Write(ptr, patch, patch.Size(), false);
+  _asserts(code[0] == 0x90 && code[1] == 0x90 && code[2] == 3, "Written bytes differ");
+}
+
+static void SafeReads()
+{
+  uint64_t value = 0x1122334455667788;
+  uint64_t read = 0;
+  auto isRead = Memory::SafeReadObject(&value, read);
+  _asserts(isRead && read == value, "Readable object was not read");
+
+  Memory::Data data = { 0xCC };
+  isRead = SafeRead(&value, data, sizeof(value));
+  _asserts(isRead && data.Size() == 9 && data[1] == 0x88, "Readable bytes were not appended");
+
+  // unreadable memory fails instead of faulting, leaving outputs alone
+  auto page = VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_NOACCESS);
+  _asserts(page, "Could not allocate test page");
+  isRead = Memory::SafeReadObject(page, read);
+  _asserts(!isRead && read == value, "Unreadable object was read");
+  isRead = SafeRead(page, data, 8);
+  _asserts(!isRead && data.Size() == 9, "Unreadable bytes were appended");
+  _asserts(!Memory::SafeReadObject(nullptr, read), "Null object was read");
+
+  // protection is restored once change goes out of scope
+  MEMORY_BASIC_INFORMATION info;
+  {
+    Memory::Protection protection(page, 0x1000, PAGE_READWRITE);
+    _asserts(protection.IsEnabled() && protection.GetOldMode() == PAGE_NOACCESS, "Protection was not changed");
+    auto isQueried = VirtualQuery(page, &info, sizeof(info));
+    _asserts(isQueried && info.Protect == PAGE_READWRITE, "Page is not writable");
+    isRead = Memory::SafeReadObject(page, read);
+    _asserts(isRead && !read, "Unprotected page was not read");
+  }
+  auto isQueried = VirtualQuery(page, &info, sizeof(info));
+  _asserts(isQueried && info.Protect == PAGE_NOACCESS, "Protection was not restored");
+  VirtualFree(page, 0, MEM_RELEASE);
+}
+
+void DataTest()
+{
+  BuildData();
+  ReadWriteData();
+  SafeReads();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "memory.h"
+
+static void ReadImage()
+{
+  Memory::Process p;
+  auto kernel32 = p.FindModule(L"kernel32.dll");
+  Memory::Image image(kernel32.GetImageFilename());
+
+  auto nt = image.GetNtHeaders();
+  _asserts(nt->FileHeader.TimeDateStamp == kernel32.GetNtHeaders()->FileHeader.TimeDateStamp,
+           "Image timestamp differs from loaded module");
+  _asserts(nt->OptionalHeader.SizeOfImage == kernel32.GetSize(), "Image size differs from loaded module");
+  _asserts(image.GetSections().size() == nt->FileHeader.NumberOfSections, "Sections were not read");
+
+  auto target = kernel32.FindExport("GetProcAddress");
+  auto rva = image.FindExport("GetProcAddress");
+  _asserts(kernel32.GetBaseAddress() + rva == target.ToValue(), "Image export differs from loaded module");
+  _asserts(!image.FindExport("NotAnExport"), "Missing export was found");
+  _asserts(image.ToRva(image.FromRva(rva)) == rva, "RVA conversion does not round trip");
+
+  auto& relocations = image.GetRelocations();
+  _asserts(is_sorted(relocations.begin(), relocations.end()), "Relocations are not sorted");
+  if (!relocations.empty())
+    _asserts(image.IsRelocated(relocations.front(), 1) && !image.IsRelocated(relocations.front() - 1, 1),
+             "Relocated range was not detected");
+
+  auto threw = false;
+  try {
+    Memory::Image invalid(L"./validConfig.lua");
+  }
+  catch (const runtime_error&) {
+    threw = true;
+  }
+  _asserts(threw, "Invalid image was opened");
+}
+
+static void PlanOffline()
+{
+  const path file = L"./plan.cache";
+  Memory::Process p;
+  auto kernel32 = p.FindModule(L"kernel32.dll");
+
+  // signature taken from the file, as a build step would
+  Memory::Image image(kernel32.GetImageFilename());
+  auto code = image.FromRva(image.FindExport("GetProcAddress"), 16);
+  string signature;
+  for (size_t i = 0; i < 16; ++i) {
+    char byte[4];
+    sprintf_s(byte, "%02X ", code.ToBytes()[i]);
+    signature += byte;
+  }
+  Memory::Pattern pattern(signature);
+
+  auto targets = Memory::Analysis::Plan(image, { { "GetProcAddress", pattern } }, file);
+  _asserts(targets.size() == 1 && targets[0].address.ToVoid(), "Plan did not resolve target");
+
+  // runtime starts with the planned target
+  Memory::Analysis analysis(kernel32, file);
+  auto resolved = analysis.Resolve("GetProcAddress", [] {
+    return Memory::Pointer(nullptr);
+  });
+  _asserts(analysis.GetHits() == 1, "Runtime did not start with planned target");
+  _asserts(resolved.address == kernel32.GetBaseAddress() + targets[0].address.ToValue(),
+           "Planned target differs from loaded module");
+  _asserts(resolved.prologue == targets[0].prologue, "Planned prologue differs");
+  remove(file);
+}
+
+void ImageTest()
+{
+  ReadImage();
+  PlanOffline();
+}
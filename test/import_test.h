@@ -0,0 +1,37 @@
+#pragma once
+
+#include "memory.h"
+
+static DWORD WINAPI FakeTickCount()
+{
+  return 42;
+}
+
+void ImportTest()
+{
+  Memory::Process p;
+  auto kernel32 = p.FindModule(L"kernel32.dll");
+  auto address = kernel32.FindExport("GetTickCount");
+  auto original = address.ToAny<decltype(&GetTickCount)>();
+  {
+    Memory::ImportHook hook(kernel32, "GetTickCount", reinterpret_cast<pvoid_t>(&FakeTickCount));
+    _asserts(hook.IsEnabled() && hook.GetSlotCount(), "Import hook was not enabled");
+    _asserts(GetTickCount() == 42, "Import slot was not swapped");
+    _asserts(hook.GetOriginal() == address && original() != 42, "Original function was not kept");
+
+    hook.Disable();
+    _asserts(!hook.IsEnabled() && GetTickCount() != 42, "Disabled hook kept slot swapped");
+    hook.Enable();
+    _asserts(GetTickCount() == 42, "Enabled hook did not swap slot again");
+  }
+  _asserts(GetTickCount() != 42, "Destroyed hook did not restore slot");
+
+  auto threw = false;
+  try {
+    Memory::ImportHook missing(kernel32, "NotAnExport", reinterpret_cast<pvoid_t>(&FakeTickCount));
+  }
+  catch (const runtime_error&) {
+    threw = true;
+  }
+  _asserts(threw, "Missing import was hooked");
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "memory.h"
+
+static void MapRegions()
+{
+  Memory::MemoryMap map;
+  auto& regions = map.GetRegions();
+  _asserts(!regions.empty(), "Address space was not mapped");
+  for (size_t i = 1; i < regions.size(); ++i)
+    _asserts(regions[i - 1].base + regions[i - 1].size <= regions[i].base, "Regions overlap");
+
+  // code of this test belongs to the base module
+  Memory::Process p;
+  auto code = map.Find(reinterpret_cast<pvoid_t>(&MapRegions));
+  _asserts(code && code->IsExecutable() && code->type == MEM_IMAGE, "Test code was not mapped as image");
+  _asserts(code->module && code->module->GetBaseAddress() == p.GetBaseModule().GetBaseAddress(),
+           "Test code was not owned by base module");
+
+  // executable regions cover this test's code too
+  string signature;
+  for (size_t i = 0; i < 16; ++i) {
+    char byte[4];
+    sprintf_s(byte, "%02X ", reinterpret_cast<const ubyte_t*>(&MapRegions)[i]);
+    signature += byte;
+  }
+  auto found = Memory::Scanner(map).FindAll(Memory::Pattern(signature));
+  _asserts(find(found.begin(), found.end(), Memory::Pointer(reinterpret_cast<pvoid_t>(&MapRegions))) != found.end(),
+           "Test code was not found in executable regions");
+
+  int local = 0;
+  auto stack = map.Find(&local);
+  _asserts(stack && stack->IsWritable() && !stack->module, "Stack was not mapped as writable");
+  _asserts(map.IsReadable(&local, sizeof(local)), "Stack was not readable");
+  _asserts(!map.Find(nullptr) && !map.IsReadable(nullptr, 1), "Null page was mapped");
+}
+
+static void RefreshRegions()
+{
+  auto page = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x3000, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+  _asserts(page, "Page was not allocated");
+  Memory::MemoryMap map;
+  auto count = map.GetRegions().size();
+  _asserts(map.Find(page + 0x1000)->protect == PAGE_READWRITE, "Page protection was not mapped");
+
+  // snapshot only changes once refreshed
+  ulong_t old;
+  VirtualProtect(page + 0x1000, 0x1000, PAGE_NOACCESS, &old);
+  _asserts(map.Find(page + 0x1000)->protect == PAGE_READWRITE, "Snapshot changed without refresh");
+  map.Refresh(page + 0x1000, 0x1000);
+  _asserts(map.Find(page + 0x1000)->protect == PAGE_NOACCESS && !map.IsReadable(page, 0x2000),
+           "Refreshed protection was not mapped");
+  _asserts(map.Find(page)->protect == PAGE_READWRITE && map.Find(page + 0x2000)->protect == PAGE_READWRITE,
+           "Neighbour pages were not kept");
+  _asserts(map.GetRegions().size() == count + 2, "Refreshed region was not split");
+
+  // writable mode is answered from snapshot
+  _asserts(Memory::Protection::GetWritableMode(map, page, 0x1000) == PAGE_READWRITE,
+           "Writable mode of data page was executable");
+  _asserts(Memory::Protection::GetWritableMode(map, reinterpret_cast<pvoid_t>(&MapRegions), 1) == PAGE_EXECUTE_READWRITE,
+           "Writable mode of code dropped execute access");
+  Memory::MemoryMap range(page + 0x1000, 1);
+  _asserts(range.GetRegions().size() == 1 && range.Find(page + 0x1000)->protect == PAGE_NOACCESS && !range.Find(page),
+           "Range snapshot was not limited to range");
+
+  VirtualFree(page, 0, MEM_RELEASE);
+  map.Refresh(page, 0x3000);
+  _asserts(!map.Find(page) && !map.Find(page + 0x2000), "Released pages were kept");
+}
+
+void MemoryMapTest()
+{
+  MapRegions();
+  RefreshRegions();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "memory.h"
+
+struct Stats {
+  int health;
+  int armor;
+};
+
+struct Player {
+  char   name[16];
+  Stats* stats;
+};
+
+struct World {
+  uintptr_t padding;
+  Player*   players[4];
+};
+
+static void FollowPath()
+{
+  Stats first = { 100, 50 }, second = { 10, 5 };
+  Player player = { "player", &first };
+  World world = { 0, { &player } };
+  World* root = &world;
+
+  // [[[&root]+players[0]]+stats]+armor
+  Memory::PointerPath armor(&root, { 0, offsetof(World, players), offsetof(Player, stats), offsetof(Stats, armor) });
+  auto address = armor.Get<int>();
+  _asserts(address == &first.armor && *address == 50, "Path was not followed");
+  auto resolved = armor.Resolve();
+  _asserts(resolved == armor.Resolve(), "Cached links resolved elsewhere");
+
+  // last link changed
+  player.stats = &second;
+  address = armor.Get<int>();
+  _asserts(address && *address == 5, "Changed last link was not followed");
+
+  // middle links are only checked by walking the whole chain again
+  world.players[0] = nullptr;
+  armor.Reset();
+  _asserts(!armor.Get<int>(), "Null link was followed");
+  world.players[0] = &player;
+  address = armor.Get<int>();
+  _asserts(address && *address == 5, "Restored middle link was not followed");
+
+  // unreadable link resolves like a null one
+  auto page = VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_NOACCESS);
+  world.players[0] = static_cast<Player*>(page);
+  armor.Reset();
+  _asserts(!armor.Get<int>(), "Unreadable link was followed");
+  world.players[0] = &player;
+  VirtualFree(page, 0, MEM_RELEASE);
+
+  Memory::PointerPath field(&first, { offsetof(Stats, armor) });
+  _asserts(field.Get<int>() == &first.armor, "Single offset path was not followed");
+}
+
+static void FollowPaths()
+{
+  Stats stats[3] = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+  Player players[3] = { { "a", &stats[0] }, { "b", &stats[1] }, { "c", &stats[2] } };
+  World world = { 0, { &players[0], &players[1], &players[2] } };
+  World* root = &world;
+
+  vector<Memory::PointerPath> paths;
+  for (uintptr_t i = 0; i < 3; ++i)
+    paths.emplace_back(&root, initializer_list<uintptr_t>{ 0, offsetof(World, players) + i * sizeof(Player*), offsetof(Player, stats), offsetof(Stats, health) });
+  paths.emplace_back(&root, initializer_list<uintptr_t>{ 0, offsetof(World, players) + 3 * sizeof(Player*), 0 });
+
+  Memory::PointerPath::ResolveAll(paths);
+  for (size_t i = 0; i < 3; ++i)
+    _asserts(paths[i].Get<int>() == &stats[i].health, "Batched path was not followed");
+  _asserts(!paths[3].Get<int>(), "Batched path followed a null link");
+}
+
+void PointerPathTest()
+{
+  FollowPath();
+  FollowPaths();
+}
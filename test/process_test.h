@@ -12,7 +12,37 @@ static void PrintCurrentProcess()
   cout << "Entry point: " << m.GetEntryPoint().ToValue() << endl;
 }
 
+static void EnumerateModules()
+{
+  Memory::Process p;
+
+  auto modules = p.GetModules();
+  _asserts(modules == p.GetModules(), "Modules were enumerated again without a module change");
+  _asserts(p.FindModule(L"KERNEL32.dll").GetBaseAddress() == reinterpret_cast<uintptr_t>(GetModuleHandleW(L"kernel32.dll")),
+           "Module name was not compared case-insensitively");
+
+  auto library = LoadLibraryW(L"version.dll");
+  _asserts(library, "Could not load test library");
+  auto loaded = p.GetModules();
+  _asserts(loaded != modules && loaded->size() > modules->size(), "Loaded module did not invalidate cache");
+  _asserts(p.FindModule(L"version.dll").GetSize(), "Loaded module was not found");
+  FreeLibrary(library);
+}
+
+static void FindExports()
+{
+  Memory::Process p;
+
+  auto kernel32 = p.FindModule(L"kernel32.dll");
+  auto handle = GetModuleHandleW(L"kernel32.dll");
+  _asserts(kernel32.FindExport("GetProcAddress").ToFunc() == GetProcAddress(handle, "GetProcAddress"), "Export was not found");
+  _asserts(kernel32.FindExport("HeapAlloc").ToFunc() == GetProcAddress(handle, "HeapAlloc"), "Forwarded export was not resolved");
+  _asserts(kernel32.FindExport("NotAnExport").ToVoid() == nullptr, "Missing export was found");
+}
+
 void ProcessTest()
 {
   PrintCurrentProcess();
+  EnumerateModules();
+  FindExports();
 }
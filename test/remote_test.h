@@ -0,0 +1,53 @@
+#pragma once
+
+#include "memory.h"
+
+static void AccessRemote()
+{
+  // current process opened like any other
+  Memory::RemoteProcess process(GetCurrentProcessId());
+  _asserts(process.GetId() == GetCurrentProcessId(), "Process id differs");
+
+  uint32_t value = 0x12345678, read = 0;
+  auto isRead = process.ReadObject(&value, read);
+  _asserts(isRead && read == value, "Remote object was not read");
+  auto isWritten = process.WriteObject(&value, 0xCAFEu);
+  _asserts(isWritten && value == 0xCAFE, "Remote object was not written");
+  _asserts(!process.ReadObject(nullptr, read), "Null remote object was read");
+}
+
+static void BatchRemote()
+{
+  Memory::RemoteProcess process(GetCurrentProcessId());
+
+  // fields close together are sampled with a single call
+  vector<uint64_t> fields(512);
+  for (size_t i = 0; i < fields.size(); ++i)
+    fields[i] = i * 3;
+  vector<uint64_t> sampled(fields.size() / 2, 0);
+
+  Memory::RemoteProcess::Batch batch;
+  for (size_t i = 0; i < sampled.size(); ++i)
+    batch.ReadObject(&fields[sampled.size() - 1 - i], sampled[i]);
+  _asserts(batch.Size() == sampled.size(), "Batch did not queue every read");
+  auto done = batch.Execute(process);
+  _asserts(done == sampled.size() && batch.GetCalls() == 1 && !batch.Size(), "Nearby reads were not merged");
+  for (size_t i = 0; i < sampled.size(); ++i)
+    _asserts(sampled[i] == fields[sampled.size() - 1 - i], "Batched read differs");
+
+  // contiguous writes are gathered, unreadable reads fail alone
+  batch.WriteObject(&fields[0], uint64_t(7));
+  batch.WriteObject(&fields[1], uint64_t(8));
+  uint64_t invalid = 0;
+  batch.ReadObject(nullptr, invalid);
+  batch.ReadObject(&fields[1], sampled[0]);
+  done = batch.Execute(process);
+  _asserts(done == 3 && batch.GetCalls() == 3, "Failed read was not isolated");
+  _asserts(fields[0] == 7 && fields[1] == 8 && sampled[0] == 8, "Writes were not applied before later reads");
+}
+
+void RemoteTest()
+{
+  AccessRemote();
+  BatchRemote();
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "memory.h"
+
+#include <random>
+
+static vector<size_t> NaiveScan(const vector<ubyte_t>& data, const Memory::Pattern& pattern)
+{
+  vector<size_t> found;
+  for (size_t i = 0; i + pattern.Size() <= data.size(); ++i) {
+    if (pattern.Match(data.data() + i))
+      found.push_back(i);
+  }
+  return found;
+}
+
+static void ParsePatterns()
+{
+  Memory::Pattern p("48 8B ?? ? 4? ?5 C3");
+  _asserts(p.Size() == 7, "Pattern size differs");
+  _asserts(p.GetMask()[2] == 0x00 && p.GetMask()[4] == 0xF0 && p.GetMask()[5] == 0x0F, "Pattern mask was not parsed");
+  _asserts(p.GetBytes()[4] == 0x40 && p.GetBytes()[6] == 0xC3, "Pattern bytes were not parsed");
+
+  const char* invalid[] = { "", "?? ??", "48 8", "48 XY", "488B" };
+  for (auto signature : invalid) {
+    auto threw = false;
+    try {
+      Memory::Pattern bad(signature);
+    }
+    catch (const runtime_error&) {
+      threw = true;
+    }
+    _asserts(threw, "Invalid signature was accepted");
+  }
+}
+
+static void ScanEveryIsa()
+{
+  // small alphabet makes lots of partial matches
+  mt19937 rng(7);
+  vector<ubyte_t> data(0x10000 + 13);
+  for (auto& byte : data)
+    byte = static_cast<ubyte_t>(0xE0 | (rng() & 3));
+
+  const char* signatures[] = { "E1", "E2 E3", "E1 ?? E2 ?3", "?? E0 E0 ?? ?? E1", "E3 E2 E1 E0 E3 E2 E1 E0" };
+  const Memory::Isa isas[] = { Memory::Isa::Scalar, Memory::Isa::Sse2, Memory::Isa::Avx2 };
+  auto supported = Memory::Scanner::GetSupportedIsa();
+  for (auto signature : signatures) {
+    Memory::Pattern pattern(signature);
+    auto expected = NaiveScan(data, pattern);
+    for (auto isa : isas) {
+      Memory::Scanner::SetIsa(isa);
+      // unaligned sizes exercise scalar tail after vector blocks
+      for (auto size : { data.size(), data.size() - 7, pattern.Size() + 31 }) {
+        Memory::Scanner scanner(data.data(), size);
+        auto found = scanner.FindAll(pattern);
+        auto count = upper_bound(expected.begin(), expected.end(), size - pattern.Size()) - expected.begin();
+        _asserts(found.size() == static_cast<size_t>(count), "FindAll found wrong amount of matches");
+        for (size_t i = 0; i < found.size(); ++i)
+          _asserts(found[i] == reinterpret_cast<uintptr_t>(data.data() + expected[i]), "FindAll found wrong match");
+        _asserts(scanner.Find(pattern) == (count ? reinterpret_cast<uintptr_t>(data.data() + expected[0]) : 0),
+                 "Find did not return first match");
+      }
+    }
+  }
+  Memory::Scanner::SetIsa(supported);
+}
+
+static void ScanPatternSet()
+{
+  mt19937 rng(11);
+  vector<ubyte_t> data(0x20000);
+  for (auto& byte : data)
+    byte = static_cast<ubyte_t>(0xE0 | (rng() & 7));
+
+  // signatures cut from data, some wildcarded, plus ones that never match
+  vector<Memory::Pattern> patterns;
+  for (auto i = 0; i < 64; ++i) {
+    auto offset = rng() % (data.size() - 16);
+    auto size = 1 + i % 12;
+    string signature;
+    for (auto j = 0; j < size; ++j) {
+      char byte[4];
+      sprintf_s(byte, "%02X ", data[offset + j]);
+      signature += (j && !(rng() % 4)) ? ((rng() & 1) ? "?? " : string{ byte[0], '?', ' ' }) : byte;
+    }
+    patterns.emplace_back(signature);
+  }
+  patterns.emplace_back("11 22 ?? 33");
+  patterns.emplace_back("?? 44");
+  Memory::PatternSet set(patterns);
+
+  Memory::Scanner scanner(data.data(), data.size());
+  auto all = scanner.FindAll(set);
+  auto first = scanner.FindFirst(set);
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    auto expected = NaiveScan(data, patterns[i]);
+    _asserts(all[i].size() == expected.size(), "PatternSet found wrong amount of matches");
+    for (size_t j = 0; j < expected.size(); ++j)
+      _asserts(all[i][j] == reinterpret_cast<uintptr_t>(data.data() + expected[j]), "PatternSet found wrong match");
+    _asserts(first[i] == (expected.empty() ? 0 : reinterpret_cast<uintptr_t>(data.data() + expected[0])),
+             "FindFirst did not return first match");
+  }
+}
+
+static void ScanParallel()
+{
+  // several 1 MB chunks, matches planted across every chunk boundary
+  vector<ubyte_t> data((4 << 20) + 77, 0x90);
+  const ubyte_t planted[] = { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xC3 };
+  for (size_t boundary = 1 << 20; boundary < data.size(); boundary += 1 << 20) {
+    for (size_t shift = 1; shift < sizeof(planted); shift += 3)
+      memcpy(data.data() + boundary - shift * 32 - shift, planted, sizeof(planted));
+    memcpy(data.data() + boundary - 4, planted, sizeof(planted));
+  }
+  Memory::Pattern pattern("48 8B 05 ?? ?? ?? ?? C3");
+  Memory::PatternSet set({ pattern, Memory::Pattern("22 ?? 44"), Memory::Pattern("C3 90 90") });
+  auto expected = NaiveScan(data, pattern);
+
+  // single thread never starts a worker, otherwise workers are kept between calls
+  auto& pool = Memory::WorkerPool::Get();
+  size_t calls = 0;
+  Memory::ParallelFor(0, [&](const size_t) { ++calls; });
+  _asserts(!calls, "ParallelFor ran tasks without work");
+
+  auto threads = Memory::GetThreadCount();
+  for (size_t count : { size_t(1), size_t(3), threads }) {
+    Memory::SetThreadCount(count);
+    pool.Stop();
+    Memory::Scanner scanner(data.data(), data.size());
+    auto found = scanner.FindAll(pattern);
+    _asserts(found.size() == expected.size(), "Parallel FindAll found wrong amount of matches");
+    for (size_t i = 0; i < found.size(); ++i)
+      _asserts(found[i] == reinterpret_cast<uintptr_t>(data.data() + expected[i]),
+               "Parallel FindAll found wrong match");
+    _asserts(scanner.Find(pattern) == found.front(), "Parallel Find did not return first match");
+
+    auto all = scanner.FindAll(set);
+    auto first = scanner.FindFirst(set);
+    for (size_t i = 0; i < set.Size(); ++i) {
+      auto naive = NaiveScan(data, set[i]);
+      _asserts(all[i].size() == naive.size() && all[i].front() == reinterpret_cast<uintptr_t>(data.data() + naive.front()),
+               "Parallel PatternSet missed matches");
+      _asserts(first[i] == all[i].front(), "Parallel FindFirst did not return first match");
+    }
+    _asserts(pool.GetSize() < count, "Pool started more workers than allowed");
+    _asserts(count == 1 || pool.GetSize(), "Pool did not keep its workers");
+  }
+  pool.Stop();
+  _asserts(!pool.GetSize(), "Pool was not stopped");
+  Memory::SetThreadCount(threads);
+}
+
+static void ScanModule()
+{
+  Memory::Process p;
+
+  auto kernel32 = p.FindModule(L"kernel32.dll");
+  auto target = kernel32.FindExport("GetProcAddress");
+
+  // build signature from the export's first bytes, wildcarding the middle
+  string signature;
+  for (size_t i = 0; i < 8; ++i) {
+    char byte[4];
+    sprintf_s(byte, "%02X ", target.ToBytes()[i]);
+    signature += (i == 3 || i == 4) ? "?? " : byte;
+  }
+
+  auto found = Memory::Scanner(kernel32).FindAll(Memory::Pattern(signature));
+  _asserts(find(found.begin(), found.end(), target) != found.end(), "Signature was not found in module");
+}
+
+void ScannerTest()
+{
+  ParsePatterns();
+  ScanEveryIsa();
+  ScanPatternSet();
+  ScanParallel();
+  ScanModule();
+}
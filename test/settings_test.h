@@ -0,0 +1,181 @@
+#pragma once
+
+#include "settings.h"
+
+static void ParseValidConfig()
+{
+  Settings::Config c(L"./validConfig.lua");
+
+  _asserts(c[L"SomeName"].GetRaw() == L"Alice", "SomeName was not parsed");
+  _asserts(c[L"SomeValue"].GetRaw() == L"10.5f", "SomeValue was not parsed");
+  _asserts(c[L"SomePath"].GetRaw() == L"./this/potato/is/mine.pdf", "SomePath was not parsed");
+  _asserts(c[L"Potato"].IsTable() && c[L"Potato"].Size() == 3, "Potato table was not parsed");
+  _asserts(c[L"Potato"][L"Color"].GetRaw() == L"yellow", "Potato.Color was not parsed");
+  _asserts(c[L"Potato"][L"some_bool"].GetRaw() == L"true", "Potato.some_bool was not parsed");
+  _asserts(c.GetHead().GetChild(0).GetName() == L"SomeName", "Entries are not in source order");
+}
+
+static void ParseSketchyConfig()
+{
+  Settings::Config c(L"./sketchyConfig.lua");
+
+  _asserts(c[L"name"].GetRaw() == L"bob", "name was not parsed");
+  _asserts(c[L"size"].GetRaw() == L"0.55050f", "size was not parsed");
+  _asserts(c[L"theop"].GetRaw() == L"isop", "theop was not parsed");
+  _asserts(c[L"map"][L"___private"].GetRaw() == L"yousee", "map.___private was not parsed");
+  _asserts(c[L"pos"].IsTable() && c[L"pos"].Size() == 2, "pos table was not parsed");
+  _asserts(c[L"pos"][L"x"].GetRaw() == L"-23", "pos.x was not parsed");
+  _asserts(c[L"y"].GetRaw() == L"53", "Value after nested table was not parsed");
+}
+
+struct SketchySettings {
+  wstring name;
+  float   size;
+  bool    isGreen;
+  int     x;
+  long    posX;
+};
+
+static void BindSketchyConfig()
+{
+  static constexpr Settings::Schema schema(
+    Settings::Field(L"name", &SketchySettings::name),
+    Settings::Field(L"size", &SketchySettings::size),
+    Settings::Field(L"map.isgreen", &SketchySettings::isGreen),
+    Settings::Field(L"x", &SketchySettings::x),
+    Settings::Field(L"pos.x", &SketchySettings::posX)
+  );
+  auto s = schema.Load(L"./sketchyConfig.lua");
+
+  _asserts(s.name == L"bob", "Schema did not bind string");
+  _asserts(s.size > 0.55f && s.size < 0.56f, "Schema did not bind float");
+  _asserts(!s.isGreen, "Schema did not bind bool");
+  _asserts(s.x == 10, "Schema did not bind int");
+  _asserts(s.posX == -23, "Schema did not bind nested key");
+}
+
+class Recorder : public Settings::Handler {
+public:
+  wstring events;
+
+  void OnKey(const wstring_view& name) override
+  {
+    events += L'k';
+    events += name;
+  }
+
+  void OnValue(const wstring_view& raw) override
+  {
+    events += L'v';
+    events += raw;
+  }
+
+  void OnTableBegin() override
+  {
+    events += L'{';
+  }
+
+  void OnTableEnd() override
+  {
+    events += L'}';
+  }
+};
+
+static void StreamConfigs()
+{
+  const path files[] = { L"./validConfig.lua", L"./sketchyConfig.lua" };
+  for (auto file = begin(files); file != end(files); ++file) {
+    Recorder whole, streamed;
+    wstring buffer;
+    Settings::Read(*file, buffer);
+    Settings::Parse(buffer, whole);
+    Settings::Stream(*file, streamed, 16);
+
+    _asserts(!whole.events.empty(), "Parser reported no events");
+    _asserts(whole.events == streamed.events, "Streamed events differ from whole buffer events");
+  }
+}
+
+static void WatchConfig()
+{
+  const path file = L"./watchedConfig.lua";
+  wofstream(file) << L"value = 1" << endl;
+
+  Settings::Watcher watcher(file);
+  _asserts((*watcher.Get())[L"value"].GetRaw() == L"1", "Watcher did not load config");
+  watcher.Start();
+  watcher.Start();
+
+  this_thread::sleep_for(chrono::milliseconds(50));
+  wofstream(file) << L"value = 2" << endl;
+  for (auto tries = 0; tries < 100 && !watcher.GetReloads(); ++tries)
+    this_thread::sleep_for(chrono::milliseconds(50));
+
+  _asserts(watcher.GetReloads(), "Watcher did not reload changed config");
+  _asserts((*watcher.Get())[L"value"].GetRaw() == L"2", "Watcher did not publish reloaded config");
+
+  // stopped watcher keeps its config and can be started again
+  watcher.Stop();
+  watcher.Stop();
+  _asserts((*watcher.Get())[L"value"].GetRaw() == L"2", "Stopped watcher lost its config");
+  watcher.Start();
+}
+
+static void CacheConfig()
+{
+  const path file = L"./cachedConfig.lua";
+  wofstream(file) << L"value = 1" << endl << L"table = { inner = 'x' }" << endl;
+  for (size_t slot = 0; slot < Settings::Cache::kSlots; ++slot)
+    remove(Settings::Cache::GetPath(file, slot));
+
+  {
+    Settings::Config parsed(file, true);
+    _asserts(!parsed.IsCached(), "Config was cached before first parse");
+  }
+  {
+    Settings::Config cached(file, true);
+    _asserts(cached.IsCached(), "Config was not read from cache");
+    _asserts(cached[L"value"].GetRaw() == L"1", "Cached value differs");
+    _asserts(cached[L"table"][L"inner"].GetRaw() == L"x", "Cached nested value differs");
+  }
+  {
+    // damaged body behind a valid header is parsed again instead of read out of bounds
+    fstream image(Settings::Cache::GetPath(file), ios::binary | ios::in | ios::out);
+    image.seekp(sizeof(Settings::Cache::Header) + offsetof(Settings::Node, name));
+    uint32_t offset = 0xFFFFFF00u;
+    image.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+  }
+  {
+    Settings::Config damaged(file, true);
+    _asserts(!damaged.IsCached(), "Damaged cache was trusted");
+    _asserts(damaged[L"table"][L"inner"].GetRaw() == L"x", "Config was not parsed again after damaged cache");
+  }
+
+  wofstream(file) << L"value = 2" << endl;
+  Settings::Config changed(file, true);
+  _asserts(!changed.IsCached(), "Stale cache was used after source changed");
+  _asserts(changed[L"value"].GetRaw() == L"2", "Changed value was not parsed");
+
+  // image still mapped by a live config is left alone, the new one goes to another slot
+  Settings::Config live(file, true);
+  _asserts(live.IsCached(), "Config was not read from cache");
+  wofstream(file) << L"value = 3" << endl;
+  {
+    Settings::Config reloaded(file, true);
+    _asserts(!reloaded.IsCached(), "Stale cache was used after source changed");
+  }
+  Settings::Config recached(file, true);
+  _asserts(recached.IsCached(), "Image was not written while another config mapped the previous one");
+  _asserts(recached[L"value"].GetRaw() == L"3", "Cached value differs");
+  _asserts(!exists(path(Settings::Cache::GetPath(file)) += L".tmp"), "Temporary image was left behind");
+}
+
+void SettingsTest()
+{
+  ParseValidConfig();
+  ParseSketchyConfig();
+  BindSketchyConfig();
+  StreamConfigs();
+  WatchConfig();
+  CacheConfig();
+}
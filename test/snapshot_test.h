@@ -0,0 +1,87 @@
+#pragma once
+
+#include "memory.h"
+
+static void DiffRanges()
+{
+  vector<ubyte_t> buffer(1000);
+  for (size_t i = 0; i < buffer.size(); ++i)
+    buffer[i] = static_cast<ubyte_t>(i * 7);
+
+  Memory::Snapshot snapshot;
+  snapshot.Add(buffer.data(), buffer.size());
+  snapshot.Add(&buffer[10], Memory::Data({ 0x46, 0x4D }));
+  _asserts(snapshot.GetCount() == 2 && snapshot.GetSize() == buffer.size() + 2, "Ranges were not added");
+  _asserts(snapshot.IsIntact() && snapshot.Diff().empty(), "Untouched ranges were changed");
+
+  // runs are reported exactly, wherever they fall in a vector block
+  buffer[0] ^= 1;
+  buffer[31] ^= 1;
+  buffer[32] ^= 1;
+  buffer[33] ^= 1;
+  buffer[999] ^= 1;
+  auto changes = snapshot.Diff();
+  _asserts(!snapshot.IsIntact() && changes.size() == 3, "Changed runs were not found");
+  _asserts(changes[0].address == Memory::Pointer(&buffer[0]) && changes[0].size == 1,
+           "Run at block start was not reported exactly");
+  _asserts(changes[1].address == Memory::Pointer(&buffer[31]) && changes[1].size == 3,
+           "Run crossing blocks was not reported exactly");
+  _asserts(changes[2].address == Memory::Pointer(&buffer[999]) && changes[2].size == 1,
+           "Run at range end was not reported exactly");
+
+  auto restored = snapshot.Restore();
+  _asserts(restored == 3 && snapshot.IsIntact(), "Changed runs were not restored");
+  _asserts(buffer[31] == static_cast<ubyte_t>(31 * 7) && buffer[999] == static_cast<ubyte_t>(999 * 7),
+           "Restored bytes are wrong");
+
+  buffer[500] = 0;
+  snapshot.Update();
+  _asserts(snapshot.IsIntact() && buffer[500] == 0, "Updated bytes were not kept");
+  snapshot.Clear();
+  _asserts(!snapshot.GetCount() && !snapshot.GetSize(), "Ranges were not cleared");
+}
+
+static void DiffPatches()
+{
+  auto code = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READ));
+  _asserts(code, "Page was not allocated");
+
+  // disabled patches are checked against original bytes, enabled ones against payload
+  Memory::Patch patch(code + 0x10);
+  patch.Assembly(Memory::Data({ 0x90, 0x90, 0xC3 }));
+  Memory::Snapshot original;
+  original.Add(patch);
+  patch.Enable();
+  _asserts(patch.IsEnabled() && code[0x12] == 0xC3, "Patch was not enabled");
+  _asserts(!original.IsIntact() && original.Diff()[0].size == 3, "Enabled patch matched original bytes");
+
+  Memory::Snapshot patched;
+  patched.Add(patch);
+  _asserts(patched.IsIntact(), "Enabled patch was changed");
+  ulong_t old;
+  VirtualProtect(code, 0x1000, PAGE_EXECUTE_READWRITE, &old);
+  code[0x11] = 0xCC;
+  auto changes = patched.Diff();
+  _asserts(changes.size() == 1 && changes[0].address == Memory::Pointer(code + 0x11) && changes[0].size == 1,
+           "Overwritten payload was not found");
+  auto restored = patched.Restore();
+  _asserts(restored == 1 && code[0x11] == 0x90, "Payload was not restored");
+
+  patch.Disable();
+  _asserts(!patch.IsEnabled() && original.IsIntact(), "Disabled patch did not match original bytes");
+  VirtualFree(code, 0, MEM_RELEASE);
+}
+
+static void DiffModule()
+{
+  Memory::Process p;
+  Memory::Snapshot snapshot(p.GetBaseModule());
+  _asserts(snapshot.GetCount() && snapshot.IsIntact(), "Module sections were not added");
+}
+
+void SnapshotTest()
+{
+  DiffRanges();
+  DiffPatches();
+  DiffModule();
+}
@@ -5,6 +5,21 @@ int main()
   try {
     _InitCli();
     ProcessTest();
+    SettingsTest();
+    ScannerTest();
+    AnalysisTest();
+    ImportTest();
+    VTableTest();
+    ImageTest();
+    PointerPathTest();
+    DataTest();
+    RemoteTest();
+    MemoryMapTest();
+    ValueScannerTest();
+    WriteWatchTest();
+    SnapshotTest();
+    WatchdogTest();
+    CaveTest();
   }
   catch (const exception& e) {
     cout << e.what() << endl << flush;
@@ -11,6 +11,21 @@
 #include <string>
 #include <assert.h>
 #include "process_test.h"
+#include "settings_test.h"
+#include "scanner_test.h"
+#include "analysis_test.h"
+#include "import_test.h"
+#include "vtable_test.h"
+#include "image_test.h"
+#include "pointerpath_test.h"
+#include "data_test.h"
+#include "remote_test.h"
+#include "memorymap_test.h"
+#include "valuescanner_test.h"
+#include "writewatch_test.h"
+#include "snapshot_test.h"
+#include "watchdog_test.h"
+#include "cave_test.h"
 
 static void _InitCli();
 static void _TerminateCli(int code);
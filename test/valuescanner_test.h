@@ -0,0 +1,117 @@
+#pragma once
+
+#include "memory.h"
+
+template<class T>
+static bool HasResult(const Memory::ValueScanner<T>& scanner, const T* address)
+{
+  auto results = scanner.GetResults();
+  return find_if(results.begin(), results.end(), [&](const pair<Memory::Pointer, T>& result) {
+    return result.first == Memory::Pointer(const_cast<T*>(address)) && result.second == *address;
+  }) != results.end();
+}
+
+static void NarrowIntegers()
+{
+  // copies of the searched value may also live on the stack, so only owned values are checked
+  vector<int32_t> values(0x10000, 0);
+  for (size_t i = 0; i < values.size(); i += 0x1000)
+    values[i] = 0x5EA5C0DE;
+
+  Memory::ValueScanner<int32_t> scanner;
+  auto count = scanner.First(Memory::Compare::Exact, 0x5EA5C0DE);
+  _asserts(count >= values.size() / 0x1000, "Integers were not found");
+  for (size_t i = 0; i < values.size(); i += 0x1000)
+    _asserts(HasResult(scanner, &values[i]), "Integer was not found");
+  _asserts(!HasResult(scanner, &values[1]), "Other integer was found");
+
+  values[0x3000] = 0x5EA5C0DF;
+  scanner.Next(Memory::Compare::Changed);
+  _asserts(HasResult(scanner, &values[0x3000]) && !HasResult(scanner, &values[0]), "Changed integer was not kept");
+
+  scanner.Next(Memory::Compare::Unchanged);
+  _asserts(HasResult(scanner, &values[0x3000]), "Unchanged integer was not kept");
+  values[0x3000] = 0x5EA5C0DE;
+  scanner.Next(Memory::Compare::Decreased);
+  _asserts(HasResult(scanner, &values[0x3000]), "Decreased integer was not kept");
+
+  // freed memory drops its candidates instead of faulting
+  auto page = static_cast<int64_t*>(VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+  _asserts(page, "Page was not allocated");
+  page[7] = 0x1234567890ABCDEF;
+  Memory::ValueScanner<int64_t> wide;
+  count = wide.First(Memory::Compare::Range, 0x1234567890ABCDEE, 0x1234567890ABCDF0);
+  _asserts(count && HasResult(wide, &page[7]), "Wide integer was not found");
+  VirtualFree(page, 0, MEM_RELEASE);
+  wide.Next(Memory::Compare::Unchanged);
+  for (auto& result : wide.GetResults())
+    _asserts(result.first != Memory::Pointer(&page[7]), "Candidate on freed page was kept");
+
+  // candidates on pages still mapped survive a freed page in the same block
+  auto pages = static_cast<int32_t*>(VirtualAlloc(nullptr, 0x3000, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+  _asserts(pages, "Pages were not allocated");
+  pages[0] = pages[0x400] = pages[0x800] = 0x0DDBA11;
+  Memory::ValueScanner<int32_t> split;
+  count = split.First(Memory::Compare::Exact, 0x0DDBA11);
+  _asserts(count >= 3, "Integers on split pages were not found");
+  VirtualFree(&pages[0x400], 0x1000, MEM_DECOMMIT);
+  split.Next(Memory::Compare::Unchanged);
+  _asserts(HasResult(split, &pages[0]) && HasResult(split, &pages[0x800]) && !HasResult(split, &pages[0x400]),
+           "Candidates on mapped pages were not kept");
+  VirtualFree(pages, 0, MEM_RELEASE);
+  split.Next(Memory::Compare::Unchanged);
+  _asserts(!HasResult(split, &pages[0]), "Candidate on released page was kept");
+
+  Memory::ValueScanner<int32_t> empty;
+  count = empty.Next(Memory::Compare::Changed);
+  _asserts(!count, "Empty scanner found candidates");
+}
+
+static void NarrowFloats()
+{
+  vector<float> floats(0x1003, 0.0f);
+  floats[0x1002] = 1337.25f;
+  floats[0x10] = 1337.75f;
+  Memory::ValueScanner<float> scanner;
+  auto count = scanner.First(Memory::Compare::Range, 1337.2f, 1337.8f);
+  _asserts(count >= 2, "Floats were not found");
+  _asserts(HasResult(scanner, &floats[0x10]) && HasResult(scanner, &floats[0x1002]), "Float in range was not found");
+
+  floats[0x10] += 1.0f;
+  scanner.Next(Memory::Compare::Increased);
+  _asserts(HasResult(scanner, &floats[0x10]) && !HasResult(scanner, &floats[0x1002]), "Increased float was not kept");
+  _asserts(scanner.GetResults(1).size() == 1, "Results were not limited");
+
+  auto heap = make_unique<double>(-9876.5);
+  Memory::ValueScanner<double> doubles;
+  count = doubles.First(Memory::Compare::Exact, -9876.5);
+  _asserts(count && HasResult(doubles, heap.get()), "Double was not found");
+  *heap = 1.0;
+  doubles.Next(Memory::Compare::Exact, 1.0);
+  _asserts(HasResult(doubles, heap.get()), "Exact double was not kept");
+  doubles.Reset();
+  _asserts(!doubles.GetCount() && doubles.GetResults().empty(), "Reset scanner kept candidates");
+}
+
+static void SkipOwnPages()
+{
+  vector<int32_t> values(0x4000, 0);
+  for (size_t i = 0; i < values.size(); i += 0x10)
+    values[i] = 0x0BADF00D;
+
+  // values kept from last scan and scan buffers are never scanned again
+  Memory::ValueScanner<int32_t> scanner;
+  auto count = scanner.First(Memory::Compare::Exact, 0x0BADF00D);
+  _asserts(count >= values.size() / 0x10, "Integers were not found");
+  auto found = scanner.First(Memory::Compare::Exact, 0x0BADF00D);
+  _asserts(found < count + values.size() / 0x10, "Copies kept by scanner were found");
+  scanner.Next(Memory::Compare::Unchanged);
+  _asserts(scanner.GetCount() <= found && HasResult(scanner, &values[0x10]), "Unchanged integer was not kept");
+}
+
+void ValueScannerTest()
+{
+  NarrowIntegers();
+  NarrowFloats();
+  SkipOwnPages();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "memory.h"
+
+// destructor declared last keeps method indices the same on every ABI
+class Animal {
+public:
+  virtual int Sound()
+  {
+    return 1;
+  }
+
+  virtual int Legs()
+  {
+    return 4;
+  }
+
+  virtual ~Animal() = default;
+};
+
+using method_t = int(__fastcall*)(Animal*, void*);
+
+// fastcall with an unused second argument takes this like a method does
+static int __fastcall FakeSound(Animal*, void*)
+{
+  return 2;
+}
+
+static int __fastcall FakeLegs(Animal*, void*)
+{
+  return 8;
+}
+
+static void SwapVTableSlot()
+{
+  Animal a, b;
+  // volatile keeps calls from being devirtualized
+  Animal* volatile first = &a;
+  Animal* volatile second = &b;
+  {
+    Memory::VTableHook hook(&a, 0, reinterpret_cast<pvoid_t>(&FakeSound));
+    _asserts(hook.IsEnabled(), "VTable hook was not enabled");
+    _asserts(first->Sound() == 2 && second->Sound() == 2 && first->Legs() == 4,
+             "VTable slot was not swapped for every object of the class");
+    _asserts(hook.GetOriginal().ToAny<method_t>()(first, nullptr) == 1, "Original method was not kept");
+
+    hook.Disable();
+    _asserts(first->Sound() == 1, "Disabled hook kept slot swapped");
+    hook.Enable();
+    _asserts(second->Sound() == 2, "Enabled hook did not swap slot again");
+  }
+  _asserts(first->Sound() == 1 && second->Sound() == 1, "Destroyed hook did not restore slot");
+}
+
+static void ShadowVTable()
+{
+  Animal a, b;
+  Animal* volatile first = &a;
+  Animal* volatile second = &b;
+  auto table = Memory::GetVTable(&a);
+  {
+    Memory::ShadowVTable shadow(&a, 2);
+    _asserts(Memory::GetVTable(&a) != table && Memory::GetVTable(&b) == table,
+             "Shadow table was not given to a single object");
+    auto original = shadow.Hook(1, reinterpret_cast<pvoid_t>(&FakeLegs));
+    _asserts(original.ToAny<method_t>()(first, nullptr) == 4, "Shadow hook did not return original method");
+    _asserts(first->Legs() == 8 && second->Legs() == 4 && first->Sound() == 1,
+             "Shadow hook affected other objects or methods");
+    _asserts(typeid(*first) == typeid(Animal), "Shadow table lost type information");
+
+    shadow.Unhook(1);
+    _asserts(first->Legs() == 4, "Unhooked method was not restored");
+  }
+  _asserts(Memory::GetVTable(&a) == table, "Detached object did not get its table back");
+}
+
+void VTableTest()
+{
+  SwapVTableSlot();
+  ShadowVTable();
+}
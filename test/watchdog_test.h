@@ -0,0 +1,97 @@
+#pragma once
+
+#include "memory.h"
+
+static void CheckPatches()
+{
+  auto code = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+  _asserts(code, "Page was not allocated");
+  Memory::Patch enabled(code);
+  enabled.Assembly(Memory::Data({ 0x90, 0x90, 0xC3 }));
+  enabled.Enable();
+  Memory::Patch disabled(code + 0x10);
+  disabled.Assembly(Memory::Data({ 0xCC }));
+
+  size_t reported = 0;
+  Memory::Watchdog watchdog([&](const Memory::Patch& patch, const bool isRestored) {
+    _asserts(&patch == &enabled && isRestored, "Wrong patch was reported");
+    ++reported;
+  });
+  watchdog.Add(enabled);
+  watchdog.Add(disabled);
+  auto found = watchdog.Check();
+  _asserts(!found && watchdog.GetChecks() == 2, "Intact patches were reported");
+
+  // toggled patches are valid either way
+  disabled.Enable();
+  found = watchdog.Check();
+  _asserts(!found, "Toggled patch was reported");
+  disabled.Disable();
+
+  // overwritten bytes are only restored once seen twice in a row
+  code[1] = 0xCC;
+  found = watchdog.Check();
+  _asserts(!found && code[1] == 0xCC, "Patch was restored after a single check");
+  found = watchdog.Check();
+  _asserts(found == 1 && code[1] == 0x90 && reported == 1 && watchdog.GetOverwrites() == 1,
+           "Overwritten patch was not restored");
+  found = watchdog.Check();
+  _asserts(!found, "Restored patch was reported");
+
+  auto isRemoved = watchdog.Remove(disabled);
+  _asserts(isRemoved, "Patch was not removed");
+  isRemoved = watchdog.Remove(disabled);
+  _asserts(!isRemoved, "Removed patch was kept");
+  code[0x10] = 0x00;
+  watchdog.Check();
+  found = watchdog.Check();
+  _asserts(!found && code[0x10] == 0x00, "Removed patch was restored");
+
+  // repairs hold patch lock, so patches are never toggled while being repaired
+  auto lock = enabled.Lock();
+  thread toggle([&] { enabled.Disable(); });
+  this_thread::sleep_for(chrono::milliseconds(10));
+  _asserts(enabled.IsEnabled() && code[0] == 0x90, "Patch was toggled while locked");
+  lock.unlock();
+  toggle.join();
+  _asserts(!enabled.IsEnabled() && code[0] == 0x00, "Patch was not disabled once unlocked");
+  watchdog.Remove(enabled);
+  VirtualFree(code, 0, MEM_RELEASE);
+}
+
+static void WatchInBackground()
+{
+  auto code = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+  _asserts(code, "Page was not allocated");
+  Memory::Patch patch(code);
+  patch.Assembly(Memory::Data({ 0xEB, 0xFE }));
+  patch.Enable();
+
+  Memory::Watchdog watchdog;
+  watchdog.Add(patch);
+  watchdog.Start(chrono::milliseconds(1), 0.5);
+  code[0] = 0xC3;
+  for (auto i = 0; i < 1000 && !watchdog.GetOverwrites(); ++i)
+    this_thread::sleep_for(chrono::milliseconds(1));
+  watchdog.Stop();
+  _asserts(watchdog.GetOverwrites() == 1 && code[0] == 0xEB && watchdog.GetChecks() >= 2,
+           "Overwritten patch was not restored in background");
+
+  auto threw = false;
+  try {
+    watchdog.Start(chrono::milliseconds(1), 0.0);
+  }
+  catch (const runtime_error&) {
+    threw = true;
+  }
+  _asserts(threw, "Invalid budget was accepted");
+
+  watchdog.Remove(patch);
+  VirtualFree(code, 0, MEM_RELEASE);
+}
+
+void WatchdogTest()
+{
+  CheckPatches();
+  WatchInBackground();
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "memory.h"
+
+static void WatchFaults()
+{
+  // ordinary memory is watched through protection faults
+  auto pages = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x4000, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+  _asserts(pages, "Pages were not allocated");
+  Memory::WriteWatch watch;
+  auto isAdded = watch.Add(pages, 0x4000);
+  _asserts(isAdded && watch.GetSize() == 0x4000, "Pages were not watched");
+  isAdded = watch.Add(pages + 0x1000, 1);
+  _asserts(!isAdded, "Overlapping range was watched");
+  auto written = watch.Poll();
+  _asserts(written.empty(), "Unwritten pages were reported");
+
+  pages[0x1010] = 1;
+  pages[0x1020] = 2; // second write to the same page does not fault
+  pages[0x3FFF] = 3;
+  written = watch.Poll();
+  _asserts(written.size() == 2 && written[0] == Memory::Pointer(pages + 0x1000) && written[1] == Memory::Pointer(pages + 0x3000),
+           "Written pages were not reported");
+  _asserts(pages[0x1010] == 1 && pages[0x1020] == 2 && pages[0x3FFF] == 3, "Written bytes were lost");
+
+  // pages are watched again after each poll
+  written = watch.Poll();
+  _asserts(written.empty(), "Pages were reported twice");
+  pages[0x1030] = 4;
+  pages[0x2000] = 5;
+  pages[0x3000] = 6;
+  written = watch.Poll();
+  _asserts(written.size() == 3 && written[1] == Memory::Pointer(pages + 0x2000),
+           "Pages written after poll were not reported");
+
+  // read-only memory can not be watched, removed pages get their protection back
+  ulong_t old;
+  auto readOnly = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_READONLY));
+  _asserts(readOnly, "Read-only page was not allocated");
+  isAdded = watch.Add(readOnly, 0x1000);
+  _asserts(!isAdded, "Read-only page was watched");
+  auto isRemoved = watch.Remove(pages);
+  _asserts(isRemoved, "Range was not removed");
+  isRemoved = watch.Remove(pages);
+  _asserts(!isRemoved && !watch.GetSize(), "Removed range was kept");
+  pages[0] = 7;
+  auto isProtected = VirtualProtect(pages, 0x4000, PAGE_READWRITE, &old);
+  _asserts(isProtected && old == PAGE_READWRITE, "Protection was not restored");
+  written = watch.Poll();
+  _asserts(written.empty(), "Removed pages were reported");
+
+  VirtualFree(readOnly, 0, MEM_RELEASE);
+  VirtualFree(pages, 0, MEM_RELEASE);
+}
+
+static void WatchTracked()
+{
+  // memory allocated for watching is tracked without faults
+  auto pages = Memory::WriteWatch::Allocate(0x3000).ToAny<ubyte_t*>();
+  Memory::WriteWatch watch;
+  auto isAdded = watch.Add(pages, 0x3000);
+  _asserts(isAdded, "Tracked pages were not watched");
+  pages[0x2004] = 1;
+  auto written = watch.Poll();
+  _asserts(written.size() == 1 && written[0] == Memory::Pointer(pages + 0x2000),
+           "Written tracked page was not reported");
+  written = watch.Poll();
+  _asserts(written.empty(), "Tracked page was reported twice");
+
+  ulong_t old;
+  auto isProtected = VirtualProtect(pages, 0x3000, PAGE_READWRITE, &old);
+  _asserts(isProtected && old == PAGE_READWRITE, "Protection of tracked pages changed");
+  VirtualFree(pages, 0, MEM_RELEASE);
+}
+
+static void WatchHeap()
+{
+  // heap pages are watched too, bookkeeping of watches never lives in them
+  auto heap = make_unique<ubyte_t[]>(0x10000);
+  auto pages = reinterpret_cast<ubyte_t*>((reinterpret_cast<uintptr_t>(heap.get()) + 0xFFF) & ~static_cast<uintptr_t>(0xFFF));
+  Memory::WriteWatch watch;
+  auto isAdded = watch.Add(pages, 0x8000);
+  _asserts(isAdded, "Heap pages were not watched");
+  for (size_t i = 0; i < 0x8000; i += 0x1000)
+    pages[i] = 1;
+  auto written = watch.Poll();
+  _asserts(written.size() == 8 && written[7] == Memory::Pointer(pages + 0x7000),
+           "Written heap pages were not reported");
+
+  // a second watch allocates its pages while heap is watched
+  auto other = static_cast<ubyte_t*>(VirtualAlloc(nullptr, 0x2000, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+  _asserts(other, "Pages were not allocated");
+  Memory::WriteWatch second;
+  isAdded = second.Add(other, 0x2000);
+  _asserts(isAdded, "Pages were not watched while heap was watched");
+  other[0x1000] = 2;
+  pages[0x10] = 3;
+  written = second.Poll();
+  _asserts(written.size() == 1 && written[0] == Memory::Pointer(other + 0x1000), "Written page was not reported");
+  written = watch.Poll();
+  _asserts(written.size() == 1 && written[0] == Memory::Pointer(pages), "Written heap page was not reported");
+  auto isRemoved = second.Remove(other);
+  _asserts(isRemoved, "Range was not removed");
+  isRemoved = watch.Remove(pages);
+  _asserts(isRemoved, "Heap range was not removed");
+  VirtualFree(other, 0, MEM_RELEASE);
+}
+
+void WriteWatchTest()
+{
+  WatchFaults();
+  WatchTracked();
+  WatchHeap();
+}